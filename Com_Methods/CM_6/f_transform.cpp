@@ -5,6 +5,8 @@
 #include <iomanip>
 #include <fstream>
 #include <functional>
+#include "../CM_7/FourierCore.h"
+#include "../CM_7/NumericTextWriter.h"
 using namespace std;
 
 #ifndef M_PI
@@ -20,6 +22,15 @@ private:
 		return (value < 0.0) ? -1.0 : 1.0;
 	}
 
+	void checkImage(const vector<complex<double>>& image, int rows, int cols) const {
+		if (!SignalProcessing::FourierCore::IsPowerOfTwo(rows) || !SignalProcessing::FourierCore::IsPowerOfTwo(cols)) {
+			throw runtime_error("Image dimensions must be powers of 2.");
+		}
+		if (image.size() != static_cast<size_t>(rows) * cols) {
+			throw runtime_error("Image size does not match its dimensions.");
+		}
+	}
+
 public:
 	vector<complex<double>> signal, spectrum, restoredSignal;
 
@@ -72,39 +83,7 @@ public:
 			throw runtime_error("Number of samples must be a power of 2.");
 		}
 
-		vector<complex<double>> buffer = signal;
-		int stages = static_cast<int>(log2(numSamples));
-
-		// Bit-reversal permutation
-		for (int i = 0; i < numSamples; ++i) {
-			int revIndex = 0;
-			for (int j = 0; j < stages; ++j) {
-				if ((i >> j) & 1) {
-					revIndex |= (1 << (stages - 1 - j));
-				}
-			}
-			if (i < revIndex) {
-				swap(buffer[i], buffer[revIndex]);
-			}
-		}
-
-		// Butterfly computations
-		for (int len = 2; len <= numSamples; len *= 2) {
-			double theta = -2.0 * M_PI / len;
-			complex<double> root(cos(theta), sin(theta));
-			for (int i = 0; i < numSamples; i += len) {
-				complex<double> w(1.0, 0.0);
-				for (int j = 0; j < len / 2; ++j) {
-					auto evenPart = buffer[i + j];
-					auto oddPart = buffer[i + j + len / 2] * w;
-					buffer[i + j] = evenPart + oddPart;
-					buffer[i + j + len / 2] = evenPart - oddPart;
-					w *= root;
-				}
-			}
-		}
-
-		spectrum = buffer;
+		SignalProcessing::FourierCore::Transform(signal, spectrum, false);
 	}
 
 	void IDFT() {
@@ -123,44 +102,31 @@ public:
 			throw runtime_error("Number of samples must be a power of 2.");
 		}
 
-		vector<complex<double>> buffer = spectrum;
-		int stages = static_cast<int>(log2(numSamples));
+		// Transform straight into restoredSignal: its storage is reused between calls
+		SignalProcessing::FourierCore::Transform(spectrum, restoredSignal, true);
 
-		// Bit-reversal permutation
-		for (int i = 0; i < numSamples; ++i) {
-			int revIndex = 0;
-			for (int j = 0; j < stages; ++j) {
-				if ((i >> j) & 1) {
-					revIndex |= (1 << (stages - 1 - j));
-				}
-			}
-			if (i < revIndex) {
-				swap(buffer[i], buffer[revIndex]);
-			}
+		// Normalize
+		for (auto& val : restoredSignal) {
+			val /= static_cast<double>(numSamples);
 		}
+	}
 
-		// Butterfly with positive angle (inverse transform)
-		for (int len = 2; len <= numSamples; len *= 2) {
-			double theta = 2.0 * M_PI / len;
-			complex<double> root(cos(theta), sin(theta));
-			for (int i = 0; i < numSamples; i += len) {
-				complex<double> w(1.0, 0.0);
-				for (int j = 0; j < len / 2; ++j) {
-					auto evenPart = buffer[i + j];
-					auto oddPart = buffer[i + j + len / 2] * w;
-					buffer[i + j] = evenPart + oddPart;
-					buffer[i + j + len / 2] = evenPart - oddPart;
-					w *= root;
-				}
-			}
-		}
+	// 2D FFT of a rows x cols image stored row by row, in place.
+	// Row and column passes run in parallel; columns are transformed through a blocked transpose
+	void FFT2D(vector<complex<double>>& image, int rows, int cols) const {
+		checkImage(image, rows, cols);
+		SignalProcessing::FourierCore::Transform2D(image, rows, cols, false);
+	}
+
+	void IFFT2D(vector<complex<double>>& image, int rows, int cols) const {
+		checkImage(image, rows, cols);
+		SignalProcessing::FourierCore::Transform2D(image, rows, cols, true);
 
 		// Normalize
-		for (auto& val : buffer) {
-			val /= static_cast<double>(numSamples);
+		double scale = 1.0 / (static_cast<double>(rows) * cols);
+		for (auto& val : image) {
+			val *= scale;
 		}
-
-		restoredSignal = buffer;
 	}
 
 	void outputSpectrum(const function<bool(int)>& selector = [](int) { return true; }) const {
@@ -178,13 +144,14 @@ public:
 		}
 	}
 
+	// Real parts, one per line, in shortest round-trip form
 	void writeSignalsToFile(const string& inputPath, const string& outputPath) const {
-		ofstream inputOut(inputPath), outputOut(outputPath);
+		SignalProcessing::NumericTextWriter inputOut(inputPath), outputOut(outputPath);
 		for (const auto& val : signal) {
-			inputOut << val.real() << '\n';
+			inputOut.Column(val.real()).EndRow();
 		}
 		for (const auto& val : restoredSignal) {
-			outputOut << val.real() << '\n';
+			outputOut.Column(val.real()).EndRow();
 		}
 	}
 };
\ No newline at end of file
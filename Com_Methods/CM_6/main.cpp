@@ -7,6 +7,7 @@
 #include <string>
 #include <fstream>
 #include "f_transform.cpp"
+#include "../CM_7/SignalSynthesis.h"
 
 using namespace std;
 
@@ -30,12 +31,11 @@ int main() {
     const double phi = M_PI / 4.0;
 
     // === 1. СОХРАНЯЕМ ИСХОДНЫЙ СИГНАЛ В ОТДЕЛЬНУЮ ПЕРЕМЕННУЮ ===
-    vector<complex<double>> originalSignal(N);
-    for (int j = 0; j < N; ++j) {
-        double term1 = A * cos(2.0 * M_PI * omega1 * j / N + phi);
-        double term2 = B * cos(2.0 * M_PI * omega2 * j / N);
-        originalSignal[j] = complex<double>(term1 + term2, 0.0);
-    }
+    // z(j) = A cos(2 pi omega1 j / N + phi) + B cos(2 pi omega2 j / N)
+    vector<complex<double>> originalSignal;
+    SignalProcessing::SignalSynthesizer originalSynthesizer;
+    originalSynthesizer.AddTone(A, omega1, phi).AddTone(B, omega2);
+    originalSynthesizer.Generate(N, originalSignal);
 
     // === 2. DFT И FFT (на базе originalSignal) ===
     SignalProcessor processor(N);
@@ -94,11 +94,11 @@ int main() {
         }
 
         // Сохранение в файлы
-        ofstream origOut("original.txt");
-        ofstream filtOut("filtered.txt");
+        SignalProcessing::NumericTextWriter origOut("original.txt", ' ');
+        SignalProcessing::NumericTextWriter filtOut("filtered.txt", ' ');
         for (int i = 0; i < N; ++i) {
-            origOut << i << " " << originalSignal[i].real() << '\n';
-            filtOut << i << " " << filteredSignal[i].real() << '\n';
+            origOut.Column(i).Column(originalSignal[i].real()).EndRow();
+            filtOut.Column(i).Column(filteredSignal[i].real()).EndRow();
         }
 
         cout << "Исходный и отфильтрованный сигналы сохранены в:\n"
@@ -118,19 +118,16 @@ int main() {
     cout << "\n" << string(80, '=') << endl;
 
     const double omega2_new = 192.0; // как и ранее
-    vector<complex<double>> signal6(N);
     int N4 = N / 4;   // 128
     int N2 = N / 2;   // 256
     int N34 = 3 * N / 4; // 384
 
-    for (int j = 0; j < N; ++j) {
-        if ((j >= 0 && j < N4) || (j > N2 && j <= N34)) {
-            signal6[j] = {0.0, 0.0}; // z(j) = 0
-        } else {
-            double term = A + B * cos(2.0 * M_PI * omega2_new * j / N);
-            signal6[j] = {term, 0.0};
-        }
-    }
+    // z(j) = 0 при 0 <= j < N/4 и N/2 < j <= 3N/4, иначе z(j) = A + B cos(2 pi omega2 j / N)
+    SignalProcessing::SignalSynthesizer::Gate gate6 = { { N4, N2 + 1 }, { N34 + 1, N } };
+    vector<complex<double>> signal6;
+    SignalProcessing::SignalSynthesizer synthesizer6;
+    synthesizer6.AddConstant(A, gate6).AddTone(B, omega2_new, 0.0, gate6);
+    synthesizer6.Generate(N, signal6);
 
     // Вычисляем DFT для нового сигнала
     SignalProcessor proc6(N);
@@ -162,9 +159,9 @@ int main() {
         }
     }
 
-    ofstream sig6Out("signal6.txt");
+    SignalProcessing::NumericTextWriter sig6Out("signal6.txt", ' ');
     for (int i = 0; i < N; ++i) {
-        sig6Out << i << " " << signal6[i].real() << '\n';
+        sig6Out.Column(i).Column(signal6[i].real()).EndRow();
     }
     return 0;
 }
\ No newline at end of file
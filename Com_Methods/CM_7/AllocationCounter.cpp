@@ -0,0 +1,53 @@
+#include "AllocationCounter.h"
+
+#ifdef SIGNAL_PROCESSING_COUNT_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<long long> allocationCount(0);
+
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    std::free(pointer);
+}
+#endif
+
+namespace SignalProcessing
+{
+    namespace Diagnostics
+    {
+        long long AllocationCount()
+        {
+#ifdef SIGNAL_PROCESSING_COUNT_ALLOCATIONS
+            return allocationCount.load(std::memory_order_relaxed);
+#else
+            return 0;
+#endif
+        }
+    }
+}
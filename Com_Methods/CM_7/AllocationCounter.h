@@ -0,0 +1,24 @@
+#pragma once
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+namespace SignalProcessing
+{
+    // Режим подсчёта выделений памяти для проверки установившегося режима:
+    // при сборке с SIGNAL_PROCESSING_COUNT_ALLOCATIONS глобальный operator new считает вызовы,
+    // без этого флага счётчик всегда равен нулю и operator new не подменяется
+    namespace Diagnostics
+    {
+        constexpr bool AllocationCountingEnabled =
+#ifdef SIGNAL_PROCESSING_COUNT_ALLOCATIONS
+            true;
+#else
+            false;
+#endif
+
+        // Число выделений во всех потоках с начала работы программы
+        long long AllocationCount();
+    }
+}
+
+#endif
@@ -0,0 +1,59 @@
+#include "BackgroundWriter.h"
+#include <stdexcept>
+
+namespace SignalProcessing
+{
+    BackgroundWriter::BackgroundWriter(size_t maxPendingWrites)
+        : queue(maxPendingWrites), finished(false)
+    {
+        worker = std::thread([this]() { WorkerLoop(); });
+    }
+
+    BackgroundWriter::~BackgroundWriter()
+    {
+        try
+        {
+            Finish();
+        }
+        catch (...)
+        {
+            // ошибки записи доступны только через явный вызов Finish
+        }
+    }
+
+    void BackgroundWriter::Submit(std::function<void()> writeTask)
+    {
+        if (!queue.Push(std::move(writeTask)))
+            throw std::runtime_error("Фоновая запись уже завершена");
+    }
+
+    void BackgroundWriter::Finish()
+    {
+        if (finished)
+            return;
+
+        finished = true;
+        queue.Close();
+        worker.join();
+        if (firstError)
+            std::rethrow_exception(firstError);
+    }
+
+    // После ошибки оставшиеся задания всё равно выполняются: остальные файлы не теряются
+    void BackgroundWriter::WorkerLoop()
+    {
+        std::function<void()> task;
+        while (queue.Pop(task))
+        {
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                if (!firstError)
+                    firstError = std::current_exception();
+            }
+        }
+    }
+}
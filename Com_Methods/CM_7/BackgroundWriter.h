@@ -0,0 +1,42 @@
+#pragma once
+#ifndef BACKGROUND_WRITER_H
+#define BACKGROUND_WRITER_H
+
+#include <exception>
+#include <functional>
+#include <thread>
+#include "BoundedQueue.h"
+
+namespace SignalProcessing
+{
+    // Фоновый поток вывода: вычислительные задачи передают ему задания записи (форматирование
+    // и запись файла) через очередь ограниченной ёмкости и не ждут диска. Если запись отстаёт,
+    // Submit блокируется, и память под готовые результаты не растёт без предела.
+    // Первое исключение задания записи пробрасывается из Finish
+    class BackgroundWriter
+    {
+    private:
+        BoundedQueue<std::function<void()>> queue;
+        std::exception_ptr firstError;
+        std::thread worker;
+        bool finished;
+
+    public:
+        explicit BackgroundWriter(size_t maxPendingWrites = 16);
+        ~BackgroundWriter();
+
+        BackgroundWriter(const BackgroundWriter&) = delete;
+        BackgroundWriter& operator=(const BackgroundWriter&) = delete;
+
+        // Задание выполняется в потоке записи; захваченные по ссылке данные должны жить до Finish
+        void Submit(std::function<void()> writeTask);
+
+        // Дожидается выполнения всех заданий и останавливает поток
+        void Finish();
+
+    private:
+        void WorkerLoop();
+    };
+}
+
+#endif
@@ -0,0 +1,38 @@
+#pragma once
+#ifndef BLOCKED_TRANSPOSE_H
+#define BLOCKED_TRANSPOSE_H
+
+#include <algorithm>
+#include "ParallelFor.h"
+
+namespace SignalProcessing
+{
+    // Сторона плитки: две плитки по 32 x 32 комплексных отсчёта (32 КБ) помещаются в L1/L2,
+    // и столбцы исходной матрицы читаются целыми строками кэша
+    constexpr int TRANSPOSE_TILE = 32;
+
+    // dst[c * dstStride + r] = src[r * srcStride + c] для r < rows, c < cols.
+    // Обход плитками, полосы плиток по строкам src распределяются между потоками
+    template <typename T>
+    void TransposeBlocked(const T* src, int srcStride, T* dst, int dstStride, int rows, int cols)
+    {
+        int tileRows = (rows + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+        Parallel::ForRange(0, tileRows, [=](int firstTile, int lastTile)
+        {
+            for (int tile = firstTile; tile < lastTile; tile++)
+            {
+                int r0 = tile * TRANSPOSE_TILE;
+                int r1 = std::min(rows, r0 + TRANSPOSE_TILE);
+                for (int c0 = 0; c0 < cols; c0 += TRANSPOSE_TILE)
+                {
+                    int c1 = std::min(cols, c0 + TRANSPOSE_TILE);
+                    for (int r = r0; r < r1; r++)
+                        for (int c = c0; c < c1; c++)
+                            dst[(long long)c * dstStride + r] = src[(long long)r * srcStride + c];
+                }
+            }
+        });
+    }
+}
+
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace SignalProcessing
+{
+    // Очередь ограниченной ёмкости между потоками: Push ждёт свободного места (обратное давление
+    // на производителей), Pop ждёт элемента. После Close новые элементы не принимаются,
+    // а Pop отдаёт оставшиеся и затем возвращает false
+    template <typename T>
+    class BoundedQueue
+    {
+    private:
+        std::deque<T> items;
+        size_t capacity;
+        bool closed;
+        std::mutex mutex;
+        std::condition_variable notFull, notEmpty;
+
+    public:
+        explicit BoundedQueue(size_t maxItems)
+            : capacity(maxItems == 0 ? 1 : maxItems), closed(false)
+        {
+        }
+
+        // false, если очередь уже закрыта
+        bool Push(T item)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            notFull.wait(lock, [this]() { return closed || items.size() < capacity; });
+            if (closed)
+                return false;
+
+            items.push_back(std::move(item));
+            lock.unlock();
+            notEmpty.notify_one();
+            return true;
+        }
+
+        // false, если очередь закрыта и пуста
+        bool Pop(T& item)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            notEmpty.wait(lock, [this]() { return closed || !items.empty(); });
+            if (items.empty())
+                return false;
+
+            item = std::move(items.front());
+            items.pop_front();
+            lock.unlock();
+            notFull.notify_one();
+            return true;
+        }
+
+        void Close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                closed = true;
+            }
+            notFull.notify_all();
+            notEmpty.notify_all();
+        }
+    };
+}
+
+#endif
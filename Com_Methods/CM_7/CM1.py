@@ -2,6 +2,8 @@ import os
 import pandas as pd
 import matplotlib.pyplot as plt
 
+from wavelet_sweep import coeffs_frame, filter_results_frame, pq_components_frame
+
 BASE_DIR = r"C:\Users\Интернет\source\repos\чм7\чм7"
 
 BASES = [
@@ -20,6 +22,9 @@ phi = 0.0
 
 def read_filter_results(basis: str, stage: int):
     """Чтение результатов фильтрации (новое название файла)"""
+    frame = filter_results_frame(BASE_DIR, basis, stage)
+    if frame is not None:
+        return frame
     # Пробуем новое имя файла
     filepath = os.path.join(BASE_DIR, f"filter_results_{basis}_stage{stage}.csv")
     if os.path.exists(filepath):
@@ -35,6 +40,9 @@ def read_filter_results(basis: str, stage: int):
 
 def read_coeffs_before(basis: str, stage: int):
     """Чтение коэффициентов до обработки (новое название файла)"""
+    frame = coeffs_frame(BASE_DIR, basis, stage)
+    if frame is not None:
+        return frame
     # Пробуем новое имя файла
     filepath = os.path.join(BASE_DIR, f"coeffs_before_{basis}_stage{stage}.csv")
     if os.path.exists(filepath):
@@ -47,6 +55,9 @@ def read_coeffs_before(basis: str, stage: int):
 
 def read_pq_components(basis: str, stage: int):
     """Чтение P и Q компонент (новое название файла)"""
+    frame = pq_components_frame(BASE_DIR, basis, stage)
+    if frame is not None:
+        return frame
     # Пробуем новое имя файла
     filepath = os.path.join(BASE_DIR, f"pq_components_{basis}_stage{stage}.csv")
     if os.path.exists(filepath):
@@ -3,6 +3,8 @@ import pandas as pd
 import matplotlib.pyplot as plt
 import numpy as np
 
+from wavelet_sweep import coeffs_frame, filter_results_frame, pq_components_frame
+
 BASE_DIR = r"C:\Users\Интернет\source\repos\чм7\чм7"
 
 BASES = [
@@ -13,6 +15,9 @@ BASES = [
 
 def read_filter_results(basis: str, stage: int):
     """Чтение результатов фильтрации"""
+    frame = filter_results_frame(BASE_DIR, basis, stage)
+    if frame is not None:
+        return frame
     filepath = os.path.join(BASE_DIR, f"filter_results_{basis}_stage{stage}.csv")
     if os.path.exists(filepath):
         return pd.read_csv(filepath)
@@ -25,6 +30,9 @@ def read_filter_results(basis: str, stage: int):
 
 def read_coeffs_before(basis: str, stage: int):
     """Чтение коэффициентов до обработки"""
+    frame = coeffs_frame(BASE_DIR, basis, stage)
+    if frame is not None:
+        return frame
     filepath = os.path.join(BASE_DIR, f"coeffs_before_{basis}_stage{stage}.csv")
     if os.path.exists(filepath):
         return pd.read_csv(filepath)
@@ -37,6 +45,9 @@ def read_coeffs_before(basis: str, stage: int):
 
 def read_pq_components(basis: str, stage: int):
     """Чтение P и Q компонент"""
+    frame = pq_components_frame(BASE_DIR, basis, stage)
+    if frame is not None:
+        return frame
     filepath = os.path.join(BASE_DIR, f"pq_components_{basis}_stage{stage}.csv")
     if os.path.exists(filepath):
         return pd.read_csv(filepath)
@@ -3,6 +3,8 @@ import pandas as pd
 import matplotlib.pyplot as plt
 import numpy as np
 
+from wavelet_sweep import coeffs_frame, filter_results_frame, pq_components_frame
+
 BASE_DIR = r"C:\Users\Интернет\source\repos\чм7\чм7"
 
 BASES = [
@@ -20,6 +22,9 @@ w2 = 190
 
 def read_coeffs_file(basis: str, stage: int, file_type: str):
     """Чтение файлов с коэффициентами"""
+    frame = coeffs_frame(BASE_DIR, basis, stage, zeroed=(file_type == "after"))
+    if frame is not None:
+        return frame
     # Пробуем разные варианты имен файлов
     possible_names = [
         f"coeffs_{file_type}_{basis}_stage{stage}.csv",
@@ -35,6 +40,9 @@ def read_coeffs_file(basis: str, stage: int, file_type: str):
 
 def read_filter_results(basis: str, stage: int):
     """Чтение результатов фильтрации"""
+    frame = filter_results_frame(BASE_DIR, basis, stage)
+    if frame is not None:
+        return frame
     possible_names = [
         f"filter_results_{basis}_stage{stage}.csv",
         f"filter_{basis}_stage{stage}.csv"
@@ -48,6 +56,9 @@ def read_filter_results(basis: str, stage: int):
 
 def read_partial_reconstruction(basis: str, stage: int):
     """Чтение частичного восстановления"""
+    frame = pq_components_frame(BASE_DIR, basis, stage)
+    if frame is not None:
+        return frame
     possible_names = [
         f"pq_components_{basis}_stage{stage}.csv",
         f"filter_prevPQ_{basis}_stage{stage}.csv"
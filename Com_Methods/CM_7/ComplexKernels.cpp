@@ -0,0 +1,508 @@
+#include "ComplexKernels.h"
+#include <atomic>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define KERNELS_HAS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC разрешает AVX-интринсики без глобального /arch
+#define KERNELS_TARGET_AVX2
+#define KERNELS_TARGET_AVX512
+#else
+#define KERNELS_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define KERNELS_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+#endif
+
+namespace SignalProcessing
+{
+    namespace Kernels
+    {
+        // std::complex<double> хранится как пара double (re, im)
+        static const double* AsDoubles(const std::complex<double>* data)
+        {
+            return reinterpret_cast<const double*>(data);
+        }
+
+        static double* AsDoubles(std::complex<double>* data)
+        {
+            return reinterpret_cast<double*>(data);
+        }
+
+        // ---------------- Скалярные реализации ----------------
+
+        static std::complex<double> ConjugateDotScalar(const std::complex<double>* a, const std::complex<double>* b,
+            int begin, int count)
+        {
+            double realPart = 0.0, imagPart = 0.0;
+            for (int i = begin; i < count; i++)
+            {
+                realPart += a[i].real() * b[i].real() + a[i].imag() * b[i].imag();
+                imagPart += a[i].imag() * b[i].real() - a[i].real() * b[i].imag();
+            }
+            return std::complex<double>(realPart, imagPart);
+        }
+
+        static void AxpyScalar(std::complex<double> alpha, const std::complex<double>* x, std::complex<double>* y,
+            int begin, int count)
+        {
+            for (int i = begin; i < count; i++)
+                y[i] += alpha * x[i];
+        }
+
+        static void PointwiseMultiplyScalar(const std::complex<double>* a, const std::complex<double>* b,
+            std::complex<double>* result, int begin, int count, bool conjugate)
+        {
+            for (int i = begin; i < count; i++)
+                result[i] = a[i] * (conjugate ? std::conj(b[i]) : b[i]);
+        }
+
+        template <typename Sample>
+        static void GatherScalar(const Sample* source, int stride, Sample* result, int begin, int count)
+        {
+            for (int i = begin; i < count; i++)
+                result[i] = source[(long long)i * stride];
+        }
+
+        template <typename Sample>
+        static void ScatterScalar(const Sample* source, Sample* result, int stride, int begin, int count)
+        {
+            for (int i = begin; i < count; i++)
+                result[(long long)i * stride] = source[i];
+        }
+
+#ifdef KERNELS_HAS_X86
+        // ---------------- AVX2 + FMA: 2 комплексных числа в регистре ----------------
+
+        // Четыре аккумулятора: re += (ar*br, ai*bi), im += (ar*bi, ai*br)
+        KERNELS_TARGET_AVX2
+        static std::complex<double> ConjugateDotAVX2(const std::complex<double>* a, const std::complex<double>* b, int count)
+        {
+            const double* pa = AsDoubles(a);
+            const double* pb = AsDoubles(b);
+            __m256d real0 = _mm256_setzero_pd(), real1 = _mm256_setzero_pd();
+            __m256d imag0 = _mm256_setzero_pd(), imag1 = _mm256_setzero_pd();
+
+            int i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                __m256d a0 = _mm256_loadu_pd(pa + 2 * i), a1 = _mm256_loadu_pd(pa + 2 * i + 4);
+                __m256d b0 = _mm256_loadu_pd(pb + 2 * i), b1 = _mm256_loadu_pd(pb + 2 * i + 4);
+                real0 = _mm256_fmadd_pd(a0, b0, real0);
+                real1 = _mm256_fmadd_pd(a1, b1, real1);
+                imag0 = _mm256_fmadd_pd(a0, _mm256_permute_pd(b0, 0x5), imag0);
+                imag1 = _mm256_fmadd_pd(a1, _mm256_permute_pd(b1, 0x5), imag1);
+            }
+            for (; i + 2 <= count; i += 2)
+            {
+                __m256d a0 = _mm256_loadu_pd(pa + 2 * i);
+                __m256d b0 = _mm256_loadu_pd(pb + 2 * i);
+                real0 = _mm256_fmadd_pd(a0, b0, real0);
+                imag0 = _mm256_fmadd_pd(a0, _mm256_permute_pd(b0, 0x5), imag0);
+            }
+
+            alignas(32) double realLanes[4], imagLanes[4];
+            _mm256_store_pd(realLanes, _mm256_add_pd(real0, real1));
+            _mm256_store_pd(imagLanes, _mm256_add_pd(imag0, imag1));
+
+            std::complex<double> result((realLanes[0] + realLanes[1]) + (realLanes[2] + realLanes[3]),
+                (imagLanes[1] - imagLanes[0]) + (imagLanes[3] - imagLanes[2]));
+            return result + ConjugateDotScalar(a, b, i, count);
+        }
+
+        // alpha * x = fmaddsub(x, re(alpha), swap(x) * im(alpha))
+        KERNELS_TARGET_AVX2
+        static void AxpyAVX2(std::complex<double> alpha, const std::complex<double>* x, std::complex<double>* y, int count)
+        {
+            const double* px = AsDoubles(x);
+            double* py = AsDoubles(y);
+            __m256d alphaReal = _mm256_set1_pd(alpha.real());
+            __m256d alphaImag = _mm256_set1_pd(alpha.imag());
+
+            int i = 0;
+            for (; i + 2 <= count; i += 2)
+            {
+                __m256d xv = _mm256_loadu_pd(px + 2 * i);
+                __m256d swapped = _mm256_mul_pd(_mm256_permute_pd(xv, 0x5), alphaImag);
+                __m256d product = _mm256_fmaddsub_pd(xv, alphaReal, swapped);
+                _mm256_storeu_pd(py + 2 * i, _mm256_add_pd(_mm256_loadu_pd(py + 2 * i), product));
+            }
+            AxpyScalar(alpha, x, y, i, count);
+        }
+
+        KERNELS_TARGET_AVX2
+        static void PointwiseMultiplyAVX2(const std::complex<double>* a, const std::complex<double>* b,
+            std::complex<double>* result, int count, bool conjugate)
+        {
+            const double* pa = AsDoubles(a);
+            const double* pb = AsDoubles(b);
+            double* pr = AsDoubles(result);
+
+            int i = 0;
+            for (; i + 2 <= count; i += 2)
+            {
+                __m256d av = _mm256_loadu_pd(pa + 2 * i);
+                __m256d bv = _mm256_loadu_pd(pb + 2 * i);
+                __m256d swapped = _mm256_mul_pd(_mm256_permute_pd(av, 0x5), _mm256_permute_pd(bv, 0xF));
+                __m256d bReal = _mm256_movedup_pd(bv);
+                _mm256_storeu_pd(pr + 2 * i, conjugate
+                    ? _mm256_fmsubadd_pd(av, bReal, swapped)
+                    : _mm256_fmaddsub_pd(av, bReal, swapped));
+            }
+            PointwiseMultiplyScalar(a, b, result, i, count, conjugate);
+        }
+
+        KERNELS_TARGET_AVX2
+        static void GatherAVX2(const std::complex<double>* source, int stride, std::complex<double>* result, int count)
+        {
+            const double* ps = AsDoubles(source);
+            double* pr = AsDoubles(result);
+
+            int i = 0;
+            for (; i + 2 <= count; i += 2)
+            {
+                __m128d low = _mm_loadu_pd(ps + 2 * ((long long)i * stride));
+                __m128d high = _mm_loadu_pd(ps + 2 * ((long long)(i + 1) * stride));
+                _mm256_storeu_pd(pr + 2 * i, _mm256_insertf128_pd(_mm256_castpd128_pd256(low), high, 1));
+            }
+            GatherScalar(source, stride, result, i, count);
+        }
+
+        KERNELS_TARGET_AVX2
+        static void ScatterAVX2(const std::complex<double>* source, std::complex<double>* result, int stride, int count)
+        {
+            const double* ps = AsDoubles(source);
+            double* pr = AsDoubles(result);
+
+            int i = 0;
+            for (; i + 2 <= count; i += 2)
+            {
+                __m256d value = _mm256_loadu_pd(ps + 2 * i);
+                _mm_storeu_pd(pr + 2 * ((long long)i * stride), _mm256_castpd256_pd128(value));
+                _mm_storeu_pd(pr + 2 * ((long long)(i + 1) * stride), _mm256_extractf128_pd(value, 1));
+            }
+            ScatterScalar(source, result, stride, i, count);
+        }
+
+        // ---------------- AVX-512F: 4 комплексных числа в регистре ----------------
+
+#if defined(__GNUC__) && !defined(__clang__)
+        // Ложные предупреждения GCC 12 о _mm512_undefined_pd внутри avx512fintrin.h -
+        // только для ядер AVX-512
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+        KERNELS_TARGET_AVX512
+        static std::complex<double> ConjugateDotAVX512(const std::complex<double>* a, const std::complex<double>* b, int count)
+        {
+            const double* pa = AsDoubles(a);
+            const double* pb = AsDoubles(b);
+            __m512d real0 = _mm512_setzero_pd(), real1 = _mm512_setzero_pd();
+            __m512d imag0 = _mm512_setzero_pd(), imag1 = _mm512_setzero_pd();
+
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m512d a0 = _mm512_loadu_pd(pa + 2 * i), a1 = _mm512_loadu_pd(pa + 2 * i + 8);
+                __m512d b0 = _mm512_loadu_pd(pb + 2 * i), b1 = _mm512_loadu_pd(pb + 2 * i + 8);
+                real0 = _mm512_fmadd_pd(a0, b0, real0);
+                real1 = _mm512_fmadd_pd(a1, b1, real1);
+                imag0 = _mm512_fmadd_pd(a0, _mm512_permute_pd(b0, 0x55), imag0);
+                imag1 = _mm512_fmadd_pd(a1, _mm512_permute_pd(b1, 0x55), imag1);
+            }
+            for (; i + 4 <= count; i += 4)
+            {
+                __m512d a0 = _mm512_loadu_pd(pa + 2 * i);
+                __m512d b0 = _mm512_loadu_pd(pb + 2 * i);
+                real0 = _mm512_fmadd_pd(a0, b0, real0);
+                imag0 = _mm512_fmadd_pd(a0, _mm512_permute_pd(b0, 0x55), imag0);
+            }
+
+            // Мнимая часть: нечётные дорожки (ai*br) минус чётные (ar*bi)
+            const __m512d signs = _mm512_set_pd(1.0, -1.0, 1.0, -1.0, 1.0, -1.0, 1.0, -1.0);
+            std::complex<double> result(_mm512_reduce_add_pd(_mm512_add_pd(real0, real1)),
+                _mm512_reduce_add_pd(_mm512_mul_pd(_mm512_add_pd(imag0, imag1), signs)));
+            return result + ConjugateDotScalar(a, b, i, count);
+        }
+
+        KERNELS_TARGET_AVX512
+        static void AxpyAVX512(std::complex<double> alpha, const std::complex<double>* x, std::complex<double>* y, int count)
+        {
+            const double* px = AsDoubles(x);
+            double* py = AsDoubles(y);
+            __m512d alphaReal = _mm512_set1_pd(alpha.real());
+            __m512d alphaImag = _mm512_set1_pd(alpha.imag());
+
+            int i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                __m512d xv = _mm512_loadu_pd(px + 2 * i);
+                __m512d swapped = _mm512_mul_pd(_mm512_permute_pd(xv, 0x55), alphaImag);
+                __m512d product = _mm512_fmaddsub_pd(xv, alphaReal, swapped);
+                _mm512_storeu_pd(py + 2 * i, _mm512_add_pd(_mm512_loadu_pd(py + 2 * i), product));
+            }
+            AxpyScalar(alpha, x, y, i, count);
+        }
+
+        KERNELS_TARGET_AVX512
+        static void PointwiseMultiplyAVX512(const std::complex<double>* a, const std::complex<double>* b,
+            std::complex<double>* result, int count, bool conjugate)
+        {
+            const double* pa = AsDoubles(a);
+            const double* pb = AsDoubles(b);
+            double* pr = AsDoubles(result);
+
+            int i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                __m512d av = _mm512_loadu_pd(pa + 2 * i);
+                __m512d bv = _mm512_loadu_pd(pb + 2 * i);
+                __m512d swapped = _mm512_mul_pd(_mm512_permute_pd(av, 0x55), _mm512_permute_pd(bv, 0xFF));
+                __m512d bReal = _mm512_movedup_pd(bv);
+                _mm512_storeu_pd(pr + 2 * i, conjugate
+                    ? _mm512_fmsubadd_pd(av, bReal, swapped)
+                    : _mm512_fmaddsub_pd(av, bReal, swapped));
+            }
+            PointwiseMultiplyScalar(a, b, result, i, count, conjugate);
+        }
+
+        // Индексы пар (re, im) для четырёх комплексных отсчётов с шагом stride
+        KERNELS_TARGET_AVX512
+        static __m512i StridedPairIndices(long long stride)
+        {
+            long long step = 2 * stride;
+            return _mm512_set_epi64(3 * step + 1, 3 * step, 2 * step + 1, 2 * step, step + 1, step, 1, 0);
+        }
+
+        KERNELS_TARGET_AVX512
+        static void GatherAVX512(const std::complex<double>* source, int stride, std::complex<double>* result, int count)
+        {
+            const double* ps = AsDoubles(source);
+            double* pr = AsDoubles(result);
+            __m512i indices = StridedPairIndices(stride);
+
+            int i = 0;
+            for (; i + 4 <= count; i += 4)
+                _mm512_storeu_pd(pr + 2 * i, _mm512_i64gather_pd(indices, ps + 2 * ((long long)i * stride), 8));
+            GatherScalar(source, stride, result, i, count);
+        }
+
+        KERNELS_TARGET_AVX512
+        static void ScatterAVX512(const std::complex<double>* source, std::complex<double>* result, int stride, int count)
+        {
+            const double* ps = AsDoubles(source);
+            double* pr = AsDoubles(result);
+            __m512i indices = StridedPairIndices(stride);
+
+            int i = 0;
+            for (; i + 4 <= count; i += 4)
+                _mm512_i64scatter_pd(pr + 2 * ((long long)i * stride), indices, _mm512_loadu_pd(ps + 2 * i), 8);
+            ScatterScalar(source, result, stride, i, count);
+        }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+        // ---------------- Выбор реализации ----------------
+
+        InstructionSet DetectInstructionSet()
+        {
+#if defined(KERNELS_HAS_X86) && defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+                return InstructionSet::Scalar;
+
+            __cpuid(info, 1);
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            bool fma = (info[2] & (1 << 12)) != 0;
+            if (!osxsave)
+                return InstructionSet::Scalar;
+
+            // ОС должна сохранять регистры YMM (биты 1-2) и ZMM (биты 5-7)
+            unsigned long long xcr0 = _xgetbv(0);
+            __cpuidex(info, 7, 0);
+            bool avx2 = (info[1] & (1 << 5)) != 0;
+            bool avx512 = (info[1] & (1 << 16)) != 0;
+
+            if (avx512 && (xcr0 & 0xE6) == 0xE6)
+                return InstructionSet::AVX512;
+            if (avx2 && fma && (xcr0 & 0x6) == 0x6)
+                return InstructionSet::AVX2;
+            return InstructionSet::Scalar;
+#elif defined(KERNELS_HAS_X86)
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+                return InstructionSet::AVX512;
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+                return InstructionSet::AVX2;
+            return InstructionSet::Scalar;
+#else
+            return InstructionSet::Scalar;
+#endif
+        }
+
+        static InstructionSet SupportedInstructionSet()
+        {
+            static const InstructionSet supported = DetectInstructionSet();
+            return supported;
+        }
+
+        static std::atomic<int> activeInstructionSet(-1);
+
+        InstructionSet GetInstructionSet()
+        {
+            int active = activeInstructionSet.load(std::memory_order_relaxed);
+            if (active < 0)
+            {
+                active = (int)SupportedInstructionSet();
+                activeInstructionSet.store(active, std::memory_order_relaxed);
+            }
+            return (InstructionSet)active;
+        }
+
+        void SetInstructionSet(InstructionSet instructionSet)
+        {
+            int active = std::min((int)instructionSet, (int)SupportedInstructionSet());
+            activeInstructionSet.store(active, std::memory_order_relaxed);
+        }
+
+        std::complex<double> ConjugateDot(const std::complex<double>* a, const std::complex<double>* b, int count)
+        {
+            switch (GetInstructionSet())
+            {
+#ifdef KERNELS_HAS_X86
+            case InstructionSet::AVX512:
+                return ConjugateDotAVX512(a, b, count);
+            case InstructionSet::AVX2:
+                return ConjugateDotAVX2(a, b, count);
+#endif
+            default:
+                return ConjugateDotScalar(a, b, 0, count);
+            }
+        }
+
+        // Четыре независимые суммы разрывают цепочку зависимостей по сложению
+        double ConjugateDot(const double* a, const double* b, int count)
+        {
+            double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+            int i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                sum0 += a[i] * b[i];
+                sum1 += a[i + 1] * b[i + 1];
+                sum2 += a[i + 2] * b[i + 2];
+                sum3 += a[i + 3] * b[i + 3];
+            }
+            for (; i < count; i++)
+                sum0 += a[i] * b[i];
+            return (sum0 + sum1) + (sum2 + sum3);
+        }
+
+        void Axpy(std::complex<double> alpha, const std::complex<double>* x, std::complex<double>* y, int count)
+        {
+            switch (GetInstructionSet())
+            {
+#ifdef KERNELS_HAS_X86
+            case InstructionSet::AVX512:
+                AxpyAVX512(alpha, x, y, count);
+                break;
+            case InstructionSet::AVX2:
+                AxpyAVX2(alpha, x, y, count);
+                break;
+#endif
+            default:
+                AxpyScalar(alpha, x, y, 0, count);
+                break;
+            }
+        }
+
+        void Axpy(double alpha, const double* x, double* y, int count)
+        {
+            for (int i = 0; i < count; i++)
+                y[i] += alpha * x[i];
+        }
+
+        static void PointwiseMultiplyDispatch(const std::complex<double>* a, const std::complex<double>* b,
+            std::complex<double>* result, int count, bool conjugate)
+        {
+            switch (GetInstructionSet())
+            {
+#ifdef KERNELS_HAS_X86
+            case InstructionSet::AVX512:
+                PointwiseMultiplyAVX512(a, b, result, count, conjugate);
+                break;
+            case InstructionSet::AVX2:
+                PointwiseMultiplyAVX2(a, b, result, count, conjugate);
+                break;
+#endif
+            default:
+                PointwiseMultiplyScalar(a, b, result, 0, count, conjugate);
+                break;
+            }
+        }
+
+        void PointwiseMultiply(const std::complex<double>* a, const std::complex<double>* b,
+            std::complex<double>* result, int count)
+        {
+            PointwiseMultiplyDispatch(a, b, result, count, false);
+        }
+
+        void PointwiseMultiplyConjugate(const std::complex<double>* a, const std::complex<double>* b,
+            std::complex<double>* result, int count)
+        {
+            PointwiseMultiplyDispatch(a, b, result, count, true);
+        }
+
+        void Gather(const std::complex<double>* source, int stride, std::complex<double>* result, int count)
+        {
+            switch (GetInstructionSet())
+            {
+#ifdef KERNELS_HAS_X86
+            case InstructionSet::AVX512:
+                GatherAVX512(source, stride, result, count);
+                break;
+            case InstructionSet::AVX2:
+                GatherAVX2(source, stride, result, count);
+                break;
+#endif
+            default:
+                GatherScalar(source, stride, result, 0, count);
+                break;
+            }
+        }
+
+        void Gather(const double* source, int stride, double* result, int count)
+        {
+            GatherScalar(source, stride, result, 0, count);
+        }
+
+        void Scatter(const std::complex<double>* source, std::complex<double>* result, int stride, int count)
+        {
+            switch (GetInstructionSet())
+            {
+#ifdef KERNELS_HAS_X86
+            case InstructionSet::AVX512:
+                ScatterAVX512(source, result, stride, count);
+                break;
+            case InstructionSet::AVX2:
+                ScatterAVX2(source, result, stride, count);
+                break;
+#endif
+            default:
+                ScatterScalar(source, result, stride, 0, count);
+                break;
+            }
+        }
+
+        void Scatter(const double* source, double* result, int stride, int count)
+        {
+            ScatterScalar(source, result, stride, 0, count);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+#ifndef COMPLEX_KERNELS_H
+#define COMPLEX_KERNELS_H
+
+#include <complex>
+
+namespace SignalProcessing
+{
+    // Векторизованные ядра для комплексных массивов с выбором набора инструкций
+    // во время выполнения (AVX-512 -> AVX2 -> скалярная реализация).
+    // Вещественные перегрузки скалярные: такие циклы компилятор векторизует сам.
+    namespace Kernels
+    {
+        enum class InstructionSet
+        {
+            Scalar = 0,
+            AVX2 = 1,
+            AVX512 = 2
+        };
+
+        // Лучший набор инструкций, поддерживаемый процессором
+        InstructionSet DetectInstructionSet();
+
+        InstructionSet GetInstructionSet();
+
+        // Принудительный выбор (например, Scalar для сверки результатов);
+        // набор, не поддерживаемый процессором, понижается до доступного
+        void SetInstructionSet(InstructionSet instructionSet);
+
+        // sum_i a[i] * conj(b[i])
+        std::complex<double> ConjugateDot(const std::complex<double>* a, const std::complex<double>* b, int count);
+        double ConjugateDot(const double* a, const double* b, int count);
+
+        // y[i] += alpha * x[i]
+        void Axpy(std::complex<double> alpha, const std::complex<double>* x, std::complex<double>* y, int count);
+        void Axpy(double alpha, const double* x, double* y, int count);
+
+        // result[i] = a[i] * b[i] или a[i] * conj(b[i]); result может совпадать с a
+        void PointwiseMultiply(const std::complex<double>* a, const std::complex<double>* b,
+            std::complex<double>* result, int count);
+        void PointwiseMultiplyConjugate(const std::complex<double>* a, const std::complex<double>* b,
+            std::complex<double>* result, int count);
+
+        // result[i] = source[i * stride]
+        void Gather(const std::complex<double>* source, int stride, std::complex<double>* result, int count);
+        void Gather(const double* source, int stride, double* result, int count);
+
+        // result[i * stride] = source[i]
+        void Scatter(const std::complex<double>* source, std::complex<double>* result, int stride, int count);
+        void Scatter(const double* source, double* result, int stride, int count);
+    }
+}
+
+#endif
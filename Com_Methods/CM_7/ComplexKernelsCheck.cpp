@@ -0,0 +1,152 @@
+// Сверка векторизованных ядер ComplexKernels с простыми циклами на std::complex.
+// Отдельная программа: собирается из тех же файлов, что и основная, с флагом
+// SIGNAL_PROCESSING_KERNEL_CHECK (main.cpp тогда не определяет свой main), например
+//   g++ -std=c++17 -O2 -DSIGNAL_PROCESSING_KERNEL_CHECK *.cpp -o kernels_check
+// Для каждого набора инструкций (Scalar, AVX2, AVX-512 - если поддерживается процессором)
+// проверяются ConjugateDot, Axpy, PointwiseMultiply(Conjugate), Gather и Scatter на длинах
+// меньше одного регистра, чётных и нечётных. Код возврата 1 - хотя бы одно расхождение
+
+#ifdef SIGNAL_PROCESSING_KERNEL_CHECK
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ComplexKernels.h"
+
+using Complex = std::complex<double>;
+using SignalProcessing::Kernels::InstructionSet;
+
+namespace
+{
+    // Допуск на одну операцию с комплексными числами порядка 1
+    const double TOLERANCE = 1e-13;
+
+    const int LENGTHS[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 15, 16, 17, 63, 64, 65, 1000, 1001 };
+    const int STRIDES[] = { 1, 2, 3, 7 };
+
+    int failures = 0;
+
+    std::vector<Complex> RandomVector(std::mt19937_64& generator, int count)
+    {
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        std::vector<Complex> values(count);
+        for (Complex& value : values)
+            value = Complex(distribution(generator), distribution(generator));
+        return values;
+    }
+
+    void Expect(bool condition, const std::string& setName, const std::string& kernel, int count, double error)
+    {
+        if (condition)
+            return;
+        failures++;
+        std::cout << "ОШИБКА: " << kernel << " (" << setName << ", длина " << count
+            << "): отклонение " << error << "\n";
+    }
+
+    // Наибольшее поэлементное отклонение
+    double MaxDifference(const std::vector<Complex>& a, const std::vector<Complex>& b)
+    {
+        double difference = 0.0;
+        for (size_t i = 0; i < a.size(); i++)
+            difference = std::max(difference, std::abs(a[i] - b[i]));
+        return difference;
+    }
+
+    void CheckLength(std::mt19937_64& generator, const std::string& setName, int count)
+    {
+        namespace K = SignalProcessing::Kernels;
+        std::vector<Complex> a = RandomVector(generator, count);
+        std::vector<Complex> b = RandomVector(generator, count);
+        const Complex alpha(0.75, -1.25);
+
+        // ConjugateDot: ошибка суммы растёт с длиной
+        Complex expectedDot = 0.0;
+        for (int i = 0; i < count; i++)
+            expectedDot += a[i] * std::conj(b[i]);
+        double dotError = std::abs(K::ConjugateDot(a.data(), b.data(), count) - expectedDot);
+        Expect(dotError <= TOLERANCE * std::max(1, count), setName, "ConjugateDot", count, dotError);
+
+        // Axpy
+        std::vector<Complex> y = b, expectedY = b;
+        for (int i = 0; i < count; i++)
+            expectedY[i] += alpha * a[i];
+        K::Axpy(alpha, a.data(), y.data(), count);
+        double axpyError = MaxDifference(y, expectedY);
+        Expect(axpyError <= TOLERANCE, setName, "Axpy", count, axpyError);
+
+        // PointwiseMultiply и PointwiseMultiplyConjugate, в том числе на месте (result = a)
+        std::vector<Complex> product(count), expectedProduct(count), expectedConjugate(count);
+        for (int i = 0; i < count; i++)
+        {
+            expectedProduct[i] = a[i] * b[i];
+            expectedConjugate[i] = a[i] * std::conj(b[i]);
+        }
+        K::PointwiseMultiply(a.data(), b.data(), product.data(), count);
+        double multiplyError = MaxDifference(product, expectedProduct);
+        Expect(multiplyError <= TOLERANCE, setName, "PointwiseMultiply", count, multiplyError);
+
+        std::vector<Complex> inPlace = a;
+        K::PointwiseMultiplyConjugate(inPlace.data(), b.data(), inPlace.data(), count);
+        double conjugateError = MaxDifference(inPlace, expectedConjugate);
+        Expect(conjugateError <= TOLERANCE, setName, "PointwiseMultiplyConjugate", count, conjugateError);
+
+        // Gather и Scatter только переставляют данные: совпадение точное
+        for (int stride : STRIDES)
+        {
+            std::vector<Complex> source = RandomVector(generator, std::max(1, count * stride));
+            std::vector<Complex> gathered(count);
+            K::Gather(source.data(), stride, gathered.data(), count);
+            bool gatherExact = true;
+            for (int i = 0; i < count; i++)
+                gatherExact = gatherExact && gathered[i] == source[(size_t)i * stride];
+            Expect(gatherExact, setName, "Gather (шаг " + std::to_string(stride) + ")", count, 0.0);
+
+            std::vector<Complex> scattered = source;
+            std::vector<Complex> expectedScatter = source;
+            for (int i = 0; i < count; i++)
+                expectedScatter[(size_t)i * stride] = a[i];
+            K::Scatter(a.data(), scattered.data(), stride, count);
+            Expect(scattered == expectedScatter, setName, "Scatter (шаг " + std::to_string(stride) + ")", count, 0.0);
+        }
+    }
+}
+
+int main()
+{
+    namespace K = SignalProcessing::Kernels;
+    const struct { InstructionSet set; const char* name; } sets[] = {
+        { InstructionSet::Scalar, "Scalar" },
+        { InstructionSet::AVX2, "AVX2" },
+        { InstructionSet::AVX512, "AVX-512" } };
+
+    for (const auto& entry : sets)
+    {
+        K::SetInstructionSet(entry.set);
+        if (K::GetInstructionSet() != entry.set)
+        {
+            std::cout << entry.name << ": не поддерживается процессором, пропущено\n";
+            continue;
+        }
+
+        std::mt19937_64 generator(2024);
+        int failuresBefore = failures;
+        for (int count : LENGTHS)
+            CheckLength(generator, entry.name, count);
+        std::cout << entry.name << ": " << (failures == failuresBefore ? "совпадает" : "РАСХОЖДЕНИЯ") << "\n";
+    }
+
+    K::SetInstructionSet(K::DetectInstructionSet());
+    if (failures > 0)
+    {
+        std::cout << "Расхождений: " << failures << "\n";
+        return 1;
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,196 @@
+#include "ConvolutionEngine.h"
+#include "FourierCore.h"
+#include "ComplexKernels.h"
+#include "WorkspacePool.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace SignalProcessing
+{
+    // До этой длины прямая свёртка быстрее блочной через БПФ
+    static const int DIRECT_CONVOLUTION_TAPS = 32;
+
+    // Длина блока БПФ относительно длины фильтра: доля полезных отсчётов блока (B - L + 1) / B >= 3/4
+    static const int BLOCK_SIZE_FACTOR = 4;
+
+    ConvolutionEngine::ConvolutionEngine(const std::vector<std::complex<double>>& filterTaps, Method convolutionMethod)
+        : filter(filterTaps), method(convolutionMethod), blockSize(0), circularSize(0)
+    {
+        if (filter.empty())
+            throw std::runtime_error("Фильтр свёртки не может быть пустым");
+
+        int L = (int)filter.size();
+        if (method == Method::Auto)
+            method = (L <= DIRECT_CONVOLUTION_TAPS) ? Method::Direct : Method::OverlapSave;
+
+        if (method == Method::Direct)
+        {
+            reversedConjugateFilter.resize(L);
+            for (int j = 0; j < L; j++)
+                reversedConjugateFilter[j] = std::conj(filter[L - 1 - j]);
+        }
+        else
+        {
+            blockSize = 1;
+            while (blockSize < BLOCK_SIZE_FACTOR * L)
+                blockSize <<= 1;
+
+            FourierCore::BuildTwiddles(blockSize, false, forwardTwiddles);
+            FourierCore::BuildTwiddles(blockSize, true, inverseTwiddles);
+
+            // Нормировка обратного БПФ включена в спектр фильтра
+            filterSpectrum.assign(blockSize, std::complex<double>(0.0, 0.0));
+            for (int j = 0; j < L; j++)
+                filterSpectrum[j] = filter[j] / double(blockSize);
+            FourierCore::TransformRadix2(filterSpectrum.data(), blockSize, forwardTwiddles);
+            block.resize(blockSize);
+        }
+
+        Reset();
+    }
+
+    void ConvolutionEngine::Reset()
+    {
+        history.assign(filter.size() - 1, std::complex<double>(0.0, 0.0));
+    }
+
+    void ConvolutionEngine::Convolve(const std::vector<std::complex<double>>& input,
+        std::vector<std::complex<double>>& output)
+    {
+        Reset();
+        ProcessBlock(input, output);
+
+        // Хвост свёртки: ещё L - 1 отсчётов на нулевом входе
+        WorkspacePool& workspace = WorkspacePool::ForThread();
+        WorkspacePool::Scope scope(workspace);
+        std::vector<std::complex<double>>& zeros = workspace.Acquire<std::complex<double>>(filter.size() - 1);
+        std::vector<std::complex<double>>& tail = workspace.Acquire<std::complex<double>>(0);
+        std::fill(zeros.begin(), zeros.end(), std::complex<double>(0.0, 0.0));
+        ProcessBlock(zeros, tail);
+        output.insert(output.end(), tail.begin(), tail.end());
+        Reset();
+    }
+
+    void ConvolutionEngine::ProcessBlock(const std::vector<std::complex<double>>& input,
+        std::vector<std::complex<double>>& output)
+    {
+        switch (method)
+        {
+        case Method::OverlapSave:
+            ProcessOverlapSave(input, output);
+            break;
+        case Method::OverlapAdd:
+            ProcessOverlapAdd(input, output);
+            break;
+        default:
+            ProcessDirect(input, output);
+            break;
+        }
+    }
+
+    void ConvolutionEngine::FilterBlock()
+    {
+        FourierCore::TransformRadix2(block.data(), blockSize, forwardTwiddles);
+        Kernels::PointwiseMultiply(block.data(), filterSpectrum.data(), block.data(), blockSize);
+        FourierCore::TransformRadix2(block.data(), blockSize, inverseTwiddles);
+    }
+
+    // extended = history + input; output[i] = sum_j extended[i + j] * h[L - 1 - j]
+    void ConvolutionEngine::ProcessDirect(const std::vector<std::complex<double>>& input,
+        std::vector<std::complex<double>>& output)
+    {
+        int L = (int)filter.size();
+        int count = (int)input.size();
+
+        extended.resize(L - 1 + count);
+        std::copy(history.begin(), history.end(), extended.begin());
+        std::copy(input.begin(), input.end(), extended.begin() + (L - 1));
+
+        output.resize(count);
+        for (int i = 0; i < count; i++)
+            output[i] = Kernels::ConjugateDot(extended.data() + i, reversedConjugateFilter.data(), L);
+
+        std::copy(extended.end() - (L - 1), extended.end(), history.begin());
+    }
+
+    // Блок длины B начинается за L - 1 отсчётов до выхода; первые L - 1 отсчётов
+    // циклической свёртки блока искажены наложением и отбрасываются
+    void ConvolutionEngine::ProcessOverlapSave(const std::vector<std::complex<double>>& input,
+        std::vector<std::complex<double>>& output)
+    {
+        int L = (int)filter.size();
+        int count = (int)input.size();
+        int step = blockSize - L + 1;
+
+        extended.resize(L - 1 + count);
+        std::copy(history.begin(), history.end(), extended.begin());
+        std::copy(input.begin(), input.end(), extended.begin() + (L - 1));
+
+        output.resize(count);
+        for (int start = 0; start < count; start += step)
+        {
+            int blockCount = std::min(step, count - start);
+            int available = std::min(blockSize, L - 1 + count - start);
+
+            std::copy(extended.begin() + start, extended.begin() + start + available, block.begin());
+            std::fill(block.begin() + available, block.end(), std::complex<double>(0.0, 0.0));
+            FilterBlock();
+
+            std::copy(block.begin() + (L - 1), block.begin() + (L - 1) + blockCount, output.begin() + start);
+        }
+
+        std::copy(extended.end() - (L - 1), extended.end(), history.begin());
+    }
+
+    // Блок из B - L + 1 входных отсчётов дополняется нулями; хвост длины L - 1
+    // прибавляется к началу следующего блока
+    void ConvolutionEngine::ProcessOverlapAdd(const std::vector<std::complex<double>>& input,
+        std::vector<std::complex<double>>& output)
+    {
+        int L = (int)filter.size();
+        int count = (int)input.size();
+        int step = blockSize - L + 1;
+
+        output.resize(count);
+        for (int start = 0; start < count; start += step)
+        {
+            int blockCount = std::min(step, count - start);
+
+            std::copy(input.begin() + start, input.begin() + start + blockCount, block.begin());
+            std::fill(block.begin() + blockCount, block.end(), std::complex<double>(0.0, 0.0));
+            FilterBlock();
+
+            for (int j = 0; j < blockCount; j++)
+                output[start + j] = block[j] + (j < L - 1 ? history[j] : std::complex<double>(0.0, 0.0));
+
+            // history[blockCount + m] читается раньше, чем перезаписывается
+            for (int m = 0; m < L - 1; m++)
+                history[m] = block[blockCount + m] +
+                    (blockCount + m < L - 1 ? history[blockCount + m] : std::complex<double>(0.0, 0.0));
+        }
+    }
+
+    void ConvolutionEngine::CircularConvolve(const std::vector<std::complex<double>>& input,
+        std::vector<std::complex<double>>& output)
+    {
+        int N = (int)input.size();
+        if (N == 0)
+        {
+            output.clear();
+            return;
+        }
+
+        if (circularSize != N)
+        {
+            std::vector<std::complex<double>> periodized(N, std::complex<double>(0.0, 0.0));
+            for (int j = 0; j < (int)filter.size(); j++)
+                periodized[j % N] += filter[j] / double(N);
+            FourierCore::Transform(periodized, circularSpectrum, false);
+            circularSize = N;
+        }
+
+        FourierCore::Transform(input, output, false);
+        Kernels::PointwiseMultiply(output.data(), circularSpectrum.data(), output.data(), N);
+        FourierCore::Transform(output, output, true);
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#ifndef CONVOLUTION_ENGINE_H
+#define CONVOLUTION_ENGINE_H
+
+#include <vector>
+#include <complex>
+
+namespace SignalProcessing
+{
+    // Свёртка с зарегистрированным фильтром: спектр фильтра считается один раз.
+    // Короткие фильтры применяются прямой свёрткой, длинные - блоками overlap-save
+    // или overlap-add с БПФ длины B ~ 4L, что даёт O(N log L) на сигнал длины N.
+    class ConvolutionEngine
+    {
+    public:
+        enum class Method
+        {
+            Auto = 0,
+            Direct = 1,
+            OverlapSave = 2,
+            OverlapAdd = 3
+        };
+
+    private:
+        std::vector<std::complex<double>> filter;
+        std::vector<std::complex<double>> reversedConjugateFilter; // для прямой свёртки через ConjugateDot
+        Method method;
+
+        // Блочная свёртка: спектр фильтра длины blockSize (с множителем 1 / blockSize)
+        int blockSize;
+        std::vector<std::complex<double>> filterSpectrum;
+        std::vector<std::complex<double>> forwardTwiddles, inverseTwiddles;
+        std::vector<std::complex<double>> block;
+
+        // Состояние потока: L - 1 последних входных отсчётов (Direct, OverlapSave)
+        // или незавершённый хвост выходных (OverlapAdd)
+        std::vector<std::complex<double>> history;
+        std::vector<std::complex<double>> extended;
+
+        // Циклическая свёртка длины circularSize
+        int circularSize;
+        std::vector<std::complex<double>> circularSpectrum;
+
+    public:
+        ConvolutionEngine(const std::vector<std::complex<double>>& filterTaps, Method convolutionMethod = Method::Auto);
+
+        Method GetMethod() const { return method; }
+
+        int GetFilterLength() const { return (int)filter.size(); }
+
+        // Линейная свёртка конечного сигнала, длина результата N + L - 1
+        void Convolve(const std::vector<std::complex<double>>& input, std::vector<std::complex<double>>& output);
+
+        // Потоковая обработка: output[n] = sum_k h[k] * x[n - k] с учётом предыдущих блоков,
+        // output той же длины, что и input
+        void ProcessBlock(const std::vector<std::complex<double>>& input, std::vector<std::complex<double>>& output);
+
+        // Сброс состояния потока
+        void Reset();
+
+        // Циклическая свёртка длины N (как SignalTransformer::ComputeConvolution);
+        // спектр периодизированного фильтра кэшируется для последней длины N
+        void CircularConvolve(const std::vector<std::complex<double>>& input, std::vector<std::complex<double>>& output);
+
+    private:
+        void ProcessDirect(const std::vector<std::complex<double>>& input, std::vector<std::complex<double>>& output);
+
+        void ProcessOverlapSave(const std::vector<std::complex<double>>& input, std::vector<std::complex<double>>& output);
+
+        void ProcessOverlapAdd(const std::vector<std::complex<double>>& input, std::vector<std::complex<double>>& output);
+
+        // block <- IFFT(FFT(block) * H)
+        void FilterBlock();
+    };
+}
+
+#endif
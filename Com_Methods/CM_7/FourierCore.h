@@ -0,0 +1,198 @@
+#pragma once
+#ifndef FOURIER_CORE_H
+#define FOURIER_CORE_H
+
+#include <algorithm>
+#include <complex>
+#include <deque>
+#include <vector>
+#include <cmath>
+#include <utility>
+#include "MathConstants.h"
+#include "ParallelFor.h"
+#include "BlockedTranspose.h"
+#include "WorkspacePool.h"
+
+namespace SignalProcessing
+{
+    // Общее ядро БПФ (используется в CM_6 и CM_7).
+    // Длина степень двойки: итеративный алгоритм Кули-Тьюки по месту, O(N log N).
+    // Произвольная длина: рекурсивное прореживание по времени до нечётного остатка.
+    namespace FourierCore
+    {
+        inline bool IsPowerOfTwo(int size)
+        {
+            return size > 0 && (size & (size - 1)) == 0;
+        }
+
+        // Таблица поворотных множителей w_k = exp(sign * 2*pi*i*k / N), k < N/2
+        inline void BuildTwiddles(int size, bool inverse, std::vector<std::complex<double>>& twiddles)
+        {
+            double sign = inverse ? 1.0 : -1.0;
+            twiddles.resize(size / 2);
+            for (int k = 0; k < size / 2; k++)
+                twiddles[k] = std::polar(1.0, sign * Constants::TWO_PI * k / size);
+        }
+
+        // Таблицы уже встречавшихся длин хранятся в потоке и строятся один раз
+        inline const std::vector<std::complex<double>>& CachedTwiddles(int size, bool inverse)
+        {
+            struct Entry
+            {
+                int size;
+                bool inverse;
+                std::vector<std::complex<double>> twiddles;
+            };
+            thread_local std::deque<Entry> cache;
+
+            for (const Entry& entry : cache)
+                if (entry.size == size && entry.inverse == inverse)
+                    return entry.twiddles;
+
+            cache.push_back(Entry{ size, inverse, {} });
+            BuildTwiddles(size, inverse, cache.back().twiddles);
+            return cache.back().twiddles;
+        }
+
+        inline void BitReversePermutation(std::complex<double>* data, int size)
+        {
+            for (int i = 1, j = 0; i < size; i++)
+            {
+                int bit = size >> 1;
+                for (; j & bit; bit >>= 1)
+                    j ^= bit;
+                j ^= bit;
+                if (i < j)
+                    std::swap(data[i], data[j]);
+            }
+        }
+
+        // Итеративное БПФ по месту, size - степень двойки
+        inline void TransformRadix2(std::complex<double>* data, int size,
+            const std::vector<std::complex<double>>& twiddles)
+        {
+            BitReversePermutation(data, size);
+
+            for (int len = 2; len <= size; len <<= 1)
+            {
+                int half = len >> 1;
+                int stride = size / len;
+                for (int i = 0; i < size; i += len)
+                {
+                    for (int j = 0; j < half; j++)
+                    {
+                        std::complex<double> evenPart = data[i + j];
+                        std::complex<double> oddPart = data[i + j + half] * twiddles[j * stride];
+                        data[i + j] = evenPart + oddPart;
+                        data[i + j + half] = evenPart - oddPart;
+                    }
+                }
+            }
+        }
+
+        // Рекурсивное БПФ для произвольной длины: чётные длины делятся пополам,
+        // нечётный остаток считается прямым ДПФ
+        inline void TransformRecursive(const std::complex<double>* input, int inputStride,
+            std::complex<double>* output, int size, bool inverse)
+        {
+            double sign = inverse ? 1.0 : -1.0;
+
+            if (size % 2 != 0)
+            {
+                for (int m = 0; m < size; m++)
+                {
+                    std::complex<double> accum(0.0, 0.0);
+                    for (int n = 0; n < size; n++)
+                        accum += input[n * inputStride] *
+                            std::polar(1.0, sign * Constants::TWO_PI * (double)((long long)m * n % size) / size);
+                    output[m] = accum;
+                }
+                return;
+            }
+
+            int halfSize = size / 2;
+            TransformRecursive(input, 2 * inputStride, output, halfSize, inverse);
+            TransformRecursive(input + inputStride, 2 * inputStride, output + halfSize, halfSize, inverse);
+
+            for (int m = 0; m < halfSize; m++)
+            {
+                std::complex<double> exponent = std::polar(1.0, sign * Constants::TWO_PI * m / size);
+                std::complex<double> U_part = output[m];
+                std::complex<double> V_part = exponent * output[m + halfSize];
+                output[m] = U_part + V_part;
+                output[m + halfSize] = U_part - V_part;
+            }
+        }
+
+        // Прямое (inverse = false) или обратное ненормированное (inverse = true) БПФ
+        inline void Transform(const std::vector<std::complex<double>>& input,
+            std::vector<std::complex<double>>& output, bool inverse)
+        {
+            int size = (int)input.size();
+            if (size == 0)
+            {
+                output.clear();
+                return;
+            }
+
+            if (IsPowerOfTwo(size))
+            {
+                if (&output != &input)
+                    output = input;
+                TransformRadix2(output.data(), size, CachedTwiddles(size, inverse));
+                return;
+            }
+
+            WorkspacePool& workspace = WorkspacePool::ForThread();
+            WorkspacePool::Scope scope(workspace);
+            std::vector<std::complex<double>>& buffer = workspace.Acquire<std::complex<double>>(size);
+            TransformRecursive(input.data(), 1, buffer.data(), size, inverse);
+            output.assign(buffer.begin(), buffer.end());
+        }
+
+        // БПФ строк матрицы rows x cols (строки подряд с шагом stride) по месту, строки - между потоками
+        inline void TransformRows(std::complex<double>* data, int stride, int rows, int cols, bool inverse)
+        {
+            bool radix2 = IsPowerOfTwo(cols);
+            const std::vector<std::complex<double>>* twiddles = radix2 ? &CachedTwiddles(cols, inverse) : nullptr;
+
+            Parallel::ForRange(0, rows, [&](int firstRow, int lastRow)
+            {
+                WorkspacePool& workspace = WorkspacePool::ForThread();
+                WorkspacePool::Scope scope(workspace);
+                std::vector<std::complex<double>>& buffer = workspace.Acquire<std::complex<double>>(radix2 ? 0 : cols);
+                for (int r = firstRow; r < lastRow; r++)
+                {
+                    std::complex<double>* row = data + (long long)r * stride;
+                    if (radix2)
+                    {
+                        TransformRadix2(row, cols, *twiddles);
+                        continue;
+                    }
+                    TransformRecursive(row, 1, buffer.data(), cols, inverse);
+                    std::copy(buffer.begin(), buffer.end(), row);
+                }
+            });
+        }
+
+        // Двумерное ненормированное БПФ матрицы rows x cols, хранящейся по строкам.
+        // Столбцы не обходятся с шагом cols: матрица транспонируется плитками,
+        // столбцы преобразуются как строки и транспонируются обратно
+        inline void Transform2D(std::vector<std::complex<double>>& data, int rows, int cols, bool inverse)
+        {
+            if (rows <= 0 || cols <= 0)
+                return;
+
+            TransformRows(data.data(), cols, rows, cols, inverse);
+
+            WorkspacePool& workspace = WorkspacePool::ForThread();
+            WorkspacePool::Scope scope(workspace);
+            std::vector<std::complex<double>>& transposed = workspace.Acquire<std::complex<double>>((size_t)rows * cols);
+            TransposeBlocked(data.data(), cols, transposed.data(), rows, rows, cols);
+            TransformRows(transposed.data(), rows, cols, rows, inverse);
+            TransposeBlocked(transposed.data(), rows, data.data(), cols, cols, rows);
+        }
+    }
+}
+
+#endif
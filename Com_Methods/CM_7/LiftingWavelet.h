@@ -0,0 +1,451 @@
+#pragma once
+#ifndef LIFTING_WAVELET_H
+#define LIFTING_WAVELET_H
+
+#include <utility>
+#include <stdexcept>
+#include "WaveletFamilies.h"
+
+namespace SignalProcessing
+{
+    // Лифтинг-схема ортогональных вейвлетов (Добеши - Свелденс).
+    // Полифазная матрица [[Le, Lo], [He, Ho]] раскладывается алгоритмом Евклида
+    // на этапе компиляции; преобразование выполняется по месту над double без буферов.
+    namespace Lifting
+    {
+        constexpr int MAX_TAPS = 16;
+        constexpr int MAX_STEPS = 16;
+        constexpr double ZERO_TOLERANCE = 1e-12;
+        // Коэффициенты шагов до этого порога считаются устойчивыми; среди таких разложений выбирается самое короткое
+        constexpr double STABLE_COEFFICIENT = 2.0;
+
+        // Полином Лорана: sum c[i] * z^(low + i); z - опережение на одну пару отсчётов
+        struct LaurentPolynomial
+        {
+            int low = 0;
+            int size = 0;
+            double c[MAX_TAPS] = {};
+        };
+
+        // Шаг лифтинга: odd += T(z) even (updateOdd) или even += T(z) odd
+        struct LiftingStep
+        {
+            bool updateOdd = true;
+            LaurentPolynomial taps;
+        };
+
+        // a[k] = evenScale * even[k + evenShift], d[k] = oddScale * odd[k + oddShift]
+        struct LiftingFactorization
+        {
+            int stepCount = 0;
+            LiftingStep steps[MAX_STEPS];
+            double evenScale = 1.0;
+            double oddScale = 1.0;
+            int evenShift = 0;
+            int oddShift = 0;
+        };
+
+        constexpr double Abs(double value)
+        {
+            return value < 0.0 ? -value : value;
+        }
+
+        constexpr double MaxAbs(const LaurentPolynomial& p)
+        {
+            double result = 0.0;
+            for (int i = 0; i < p.size; i++)
+                if (Abs(p.c[i]) > result)
+                    result = Abs(p.c[i]);
+            return result;
+        }
+
+        // Отбрасывание крайних коэффициентов, малых относительно scale
+        constexpr void Trim(LaurentPolynomial& p, double scale)
+        {
+            double tolerance = ZERO_TOLERANCE * scale;
+            int first = 0;
+            while (first < p.size && Abs(p.c[first]) <= tolerance)
+                first++;
+            int last = p.size - 1;
+            while (last >= first && Abs(p.c[last]) <= tolerance)
+                last--;
+
+            int newSize = last - first + 1;
+            for (int i = 0; i < newSize; i++)
+                p.c[i] = p.c[first + i];
+            for (int i = newSize; i < MAX_TAPS; i++)
+                p.c[i] = 0.0;
+            p.low = (newSize > 0) ? p.low + first : 0;
+            p.size = newSize;
+        }
+
+        constexpr void Trim(LaurentPolynomial& p)
+        {
+            Trim(p, MaxAbs(p));
+        }
+
+        // a - q * b
+        constexpr LaurentPolynomial SubtractProduct(const LaurentPolynomial& a,
+            const LaurentPolynomial& q, const LaurentPolynomial& b)
+        {
+            if (q.size == 0 || b.size == 0)
+                return a;
+
+            int productLow = q.low + b.low;
+            int productHigh = productLow + q.size + b.size - 2;
+            int low = (a.size > 0 && a.low < productLow) ? a.low : productLow;
+            int high = (a.size > 0 && a.low + a.size - 1 > productHigh) ? a.low + a.size - 1 : productHigh;
+            if (high - low + 1 > MAX_TAPS)
+                throw std::logic_error("Lifting: polynomial exceeds MAX_TAPS");
+
+            LaurentPolynomial result;
+            result.low = low;
+            result.size = high - low + 1;
+            for (int i = 0; i < a.size; i++)
+                result.c[a.low - low + i] += a.c[i];
+            for (int i = 0; i < q.size; i++)
+                for (int j = 0; j < b.size; j++)
+                    result.c[productLow - low + i + j] -= q.c[i] * b.c[j];
+            return result;
+        }
+
+        // Деление с остатком: a = q * b + remainder, остаток короче b.
+        // topCount старших коэффициентов частного сокращают старшие члены a, остальные - младшие
+        constexpr LaurentPolynomial Divide(const LaurentPolynomial& a, const LaurentPolynomial& b,
+            int topCount, LaurentPolynomial& remainder)
+        {
+            remainder = a;
+            LaurentPolynomial q;
+            q.size = a.size - b.size + 1;
+            q.low = a.low - b.low;
+
+            for (int step = 0; step < q.size; step++)
+            {
+                bool fromTop = step < topCount;
+                int i = fromTop ? q.size - 1 - step : step - topCount;
+                int target = fromTop ? i + b.size - 1 : i;
+                double factor = remainder.c[target] / (fromTop ? b.c[b.size - 1] : b.c[0]);
+                q.c[i] = factor;
+                for (int j = 0; j < b.size; j++)
+                    remainder.c[i + j] -= factor * b.c[j];
+                remainder.c[target] = 0.0;
+            }
+            Trim(remainder, MaxAbs(a));
+            return q;
+        }
+
+        constexpr void AddStep(LiftingFactorization& scheme, bool updateOdd, const LaurentPolynomial& taps)
+        {
+            if (scheme.stepCount >= MAX_STEPS)
+                throw std::logic_error("Lifting: too many steps");
+            scheme.steps[scheme.stepCount].updateOdd = updateOdd;
+            scheme.steps[scheme.stepCount].taps = taps;
+            scheme.stepCount++;
+        }
+
+        // Промежуточное состояние разложения: текущая полифазная матрица и найденные шаги
+        struct FactorizationState
+        {
+            LaurentPolynomial lowEven, lowOdd, highEven, highOdd;
+            LiftingFactorization scheme;
+            double cost = STABLE_COEFFICIENT; // максимальный по модулю коэффициент шагов и масштабов
+            int work = 0;                     // число умножений на пару отсчётов
+        };
+
+        constexpr double Max(double a, double b)
+        {
+            return a > b ? a : b;
+        }
+
+        // Столбец 2 -= q * столбец 1  <=>  even += q * odd;  столбец 1 -= q * столбец 2  <=>  odd += q * even
+        constexpr void ApplyColumnStep(FactorizationState& state, bool updateOdd, const LaurentPolynomial& q)
+        {
+            if (updateOdd)
+            {
+                state.lowEven = SubtractProduct(state.lowEven, q, state.lowOdd);
+                state.highEven = SubtractProduct(state.highEven, q, state.highOdd);
+            }
+            else
+            {
+                state.lowOdd = SubtractProduct(state.lowOdd, q, state.lowEven);
+                state.highOdd = SubtractProduct(state.highOdd, q, state.highEven);
+            }
+            Trim(state.highEven);
+            Trim(state.highOdd);
+            AddStep(state.scheme, updateOdd, q);
+            state.cost = Max(state.cost, MaxAbs(q));
+            state.work += q.size;
+        }
+
+        // Завершение после алгоритма Евклида: первая строка (m, 0) или (0, m), m - одночлен.
+        // Возвращает false, если матрица не приводится к диагональной
+        constexpr bool Finish(FactorizationState& state)
+        {
+            if (state.lowEven.size == 0)
+            {
+                // (0, m) -> (1, m) -> (1, 0)
+                LaurentPolynomial inverse;
+                inverse.size = 1;
+                inverse.low = -state.lowOdd.low;
+                inverse.c[0] = -1.0 / state.lowOdd.c[0];
+                ApplyColumnStep(state, true, inverse);
+                Trim(state.lowEven);
+
+                LaurentPolynomial monomial = state.lowOdd;
+                ApplyColumnStep(state, false, monomial);
+                state.lowOdd.size = 0;
+            }
+
+            // det P - одночлен, поэтому highOdd - одночлен; исключаем highEven
+            if (state.lowEven.size != 1 || state.highOdd.size != 1)
+                return false;
+
+            if (state.highEven.size > 0)
+            {
+                LaurentPolynomial q = state.highEven;
+                q.low -= state.highOdd.low;
+                for (int i = 0; i < q.size; i++)
+                    q.c[i] /= state.highOdd.c[0];
+                ApplyColumnStep(state, true, q);
+            }
+
+            LiftingFactorization& scheme = state.scheme;
+            scheme.evenScale = state.lowEven.c[0];
+            scheme.evenShift = state.lowEven.low;
+            scheme.oddScale = state.highOdd.c[0];
+            scheme.oddShift = state.highOdd.low;
+            state.cost = Max(state.cost, Max(Abs(scheme.evenScale), 1.0 / Abs(scheme.evenScale)));
+            state.cost = Max(state.cost, Max(Abs(scheme.oddScale), 1.0 / Abs(scheme.oddScale)));
+            state.work += 2;
+            return true;
+        }
+
+        constexpr bool IsBetter(const FactorizationState& candidate, const FactorizationState& best)
+        {
+            return candidate.cost < best.cost || (candidate.cost == best.cost && candidate.work < best.work);
+        }
+
+        // Перебор вариантов деления в алгоритме Евклида с отсечением: выбирается наиболее
+        // устойчивое разложение (наименьшие коэффициенты шагов), при равенстве - с меньшим числом умножений
+        constexpr void Search(const FactorizationState& state, FactorizationState& best, bool& found)
+        {
+            if (found && !IsBetter(state, best))
+                return;
+
+            if (state.lowEven.size == 0 || state.lowOdd.size == 0)
+            {
+                FactorizationState finished = state;
+                if (Finish(finished) && (!found || IsBetter(finished, best)))
+                {
+                    best = finished;
+                    found = true;
+                }
+                return;
+            }
+
+            for (int reduceOdd = 0; reduceOdd < 2; reduceOdd++)
+            {
+                const LaurentPolynomial& dividend = reduceOdd ? state.lowOdd : state.lowEven;
+                const LaurentPolynomial& divisor = reduceOdd ? state.lowEven : state.lowOdd;
+                if (dividend.size < divisor.size)
+                    continue;
+
+                int quotientSize = dividend.size - divisor.size + 1;
+                for (int topCount = 0; topCount <= quotientSize; topCount++)
+                {
+                    LaurentPolynomial remainder;
+                    LaurentPolynomial q = Divide(dividend, divisor, topCount, remainder);
+
+                    FactorizationState next = state;
+                    ApplyColumnStep(next, !reduceOdd, q);
+                    if (reduceOdd) next.lowOdd = remainder;
+                    else next.lowEven = remainder;
+                    Search(next, best, found);
+                }
+            }
+        }
+
+        // Столбцовые операции P * E приводят полифазную матрицу P к диагональной из одночленов;
+        // обратные операции E^(-1) в порядке их применения - шаги лифтинга
+        template <typename Family>
+        constexpr LiftingFactorization Factorize()
+        {
+            FactorizationState state;
+            LaurentPolynomial& lowEven = state.lowEven;
+            LaurentPolynomial& lowOdd = state.lowOdd;
+            LaurentPolynomial& highEven = state.highEven;
+            LaurentPolynomial& highOdd = state.highOdd;
+
+            lowEven.size = (Family::Length + 1) / 2;
+            lowOdd.size = Family::Length / 2;
+            for (int k = 0; k < Family::Length; k++)
+            {
+                if (k % 2 == 0) lowEven.c[k / 2] = Family::Lowpass[k];
+                else lowOdd.c[k / 2] = Family::Lowpass[k];
+            }
+
+            // h[k] = sign * (-1)^(k+1) * l[1 - k], k = 2 - Length .. 1
+            int highLow = 2 - Family::Length;
+            highEven.low = highLow / 2;
+            highOdd.low = (highLow - 1) / 2;
+            highEven.size = (1 - highLow) / 2 + 1;
+            highOdd.size = (1 - highLow) / 2 + 1;
+            for (int k = highLow; k <= 1; k++)
+            {
+                bool even = (k % 2 == 0);
+                double value = Family::HighpassSign * (even ? -1.0 : 1.0) * Family::Lowpass[1 - k];
+                if (even) highEven.c[k / 2 - highEven.low] = value;
+                else highOdd.c[(k - 1) / 2 - highOdd.low] = value;
+            }
+            Trim(lowEven); Trim(lowOdd); Trim(highEven); Trim(highOdd);
+
+            FactorizationState best;
+            bool found = false;
+            Search(state, best, found);
+            if (!found)
+                throw std::logic_error("Lifting: polyphase matrix is not unimodular");
+            return best.scheme;
+        }
+    }
+
+    // Вейвлет-преобразование лифтингом для семейства из WaveletFamilies.
+    // Отсчёты берутся с шагом stride; после Forward на чётных местах - a[k], на нечётных - d[k]
+    template <typename Family>
+    class LiftingWavelet
+    {
+    public:
+        static constexpr Lifting::LiftingFactorization Scheme = Lifting::Factorize<Family>();
+
+        // Один уровень по месту: count отсчётов data[0], data[stride], ...
+        static void Forward(double* data, int count, int stride = 1)
+        {
+            int pairs = count / 2;
+            ApplySteps(data, pairs, stride, std::make_index_sequence<Scheme.stepCount>{});
+            ScaleAndShift(data, pairs, stride, true);
+        }
+
+        static void Inverse(double* data, int count, int stride = 1)
+        {
+            int pairs = count / 2;
+            ScaleAndShift(data, pairs, stride, false);
+            ApplyStepsReversed(data, pairs, stride, std::make_index_sequence<Scheme.stepCount>{});
+        }
+
+        // Уровни 1..stages по месту: a_s[k] = data[k << s], d_s[k] = data[(2k + 1) << (s - 1)]
+        static void ForwardMultilevel(double* data, int size, int stages)
+        {
+            for (int i = 0; i < stages; i++)
+                Forward(data, size >> i, 1 << i);
+        }
+
+        static void InverseMultilevel(double* data, int size, int stages)
+        {
+            for (int i = stages - 1; i >= 0; i--)
+                Inverse(data, size >> i, 1 << i);
+        }
+
+    private:
+        template <std::size_t... Steps>
+        static void ApplySteps(double* data, int pairs, int stride, std::index_sequence<Steps...>)
+        {
+            (ApplyStep<Steps, false>(data, pairs, stride), ...);
+        }
+
+        template <std::size_t... Steps>
+        static void ApplyStepsReversed(double* data, int pairs, int stride, std::index_sequence<Steps...>)
+        {
+            (ApplyStep<sizeof...(Steps) - 1 - Steps, true>(data, pairs, stride), ...);
+        }
+
+        template <std::size_t Step, std::size_t... Taps>
+        static double SumTaps(const double* source, int step, std::index_sequence<Taps...>)
+        {
+            return (0.0 + ... + (Scheme.steps[Step].taps.c[Taps] * source[(int)Taps * step]));
+        }
+
+        // target[k] +=/-= sum_j c[j] * source[(k + low + j) mod pairs]
+        template <std::size_t Step, bool Subtract>
+        static void ApplyStep(double* data, int pairs, int stride)
+        {
+            constexpr Lifting::LiftingStep step = Scheme.steps[Step];
+            constexpr int low = step.taps.low;
+            constexpr int size = step.taps.size;
+
+            int pairStride = 2 * stride;
+            double* target = data + (step.updateOdd ? stride : 0);
+            const double* source = data + (step.updateOdd ? 0 : stride);
+
+            // Внутренние пары без выхода за границы - развёрнутая сумма
+            int interiorBegin = (low < 0) ? -low : 0;
+            int interiorEnd = pairs - low - size + 1;
+            if (interiorBegin > pairs) interiorBegin = pairs;
+            if (interiorEnd > pairs) interiorEnd = pairs;
+            if (interiorEnd < interiorBegin) interiorEnd = interiorBegin;
+
+            for (int k = interiorBegin; k < interiorEnd; k++)
+            {
+                double accum = SumTaps<Step>(source + (k + low) * pairStride, pairStride,
+                    std::make_index_sequence<size>{});
+                target[k * pairStride] += Subtract ? -accum : accum;
+            }
+
+            // Граничные пары с периодическим продолжением
+            for (int k = 0; k < interiorBegin; k++)
+                ApplyBoundaryPair<Subtract>(step.taps, target, source, k, pairs, pairStride);
+            for (int k = interiorEnd; k < pairs; k++)
+                ApplyBoundaryPair<Subtract>(step.taps, target, source, k, pairs, pairStride);
+        }
+
+        template <bool Subtract>
+        static void ApplyBoundaryPair(const Lifting::LaurentPolynomial& taps, double* target,
+            const double* source, int k, int pairs, int pairStride)
+        {
+            double accum = 0.0;
+            for (int j = 0; j < taps.size; j++)
+            {
+                int idx = (k + taps.low + j) % pairs;
+                if (idx < 0) idx += pairs;
+                accum += taps.c[j] * source[idx * pairStride];
+            }
+            target[k * pairStride] += Subtract ? -accum : accum;
+        }
+
+        // Циклический сдвиг влево на shift элементов подпоследовательности с шагом step (три разворота)
+        static void RotateLeft(double* data, int count, int step, int shift)
+        {
+            shift %= count;
+            if (shift < 0) shift += count;
+            if (shift == 0)
+                return;
+            Reverse(data, 0, shift, step);
+            Reverse(data, shift, count, step);
+            Reverse(data, 0, count, step);
+        }
+
+        static void Reverse(double* data, int begin, int end, int step)
+        {
+            for (int i = begin, j = end - 1; i < j; i++, j--)
+                std::swap(data[i * step], data[j * step]);
+        }
+
+        static void ScaleAndShift(double* data, int pairs, int stride, bool forward)
+        {
+            int pairStride = 2 * stride;
+            double evenFactor = forward ? Scheme.evenScale : 1.0 / Scheme.evenScale;
+            double oddFactor = forward ? Scheme.oddScale : 1.0 / Scheme.oddScale;
+            int direction = forward ? 1 : -1;
+
+            for (int k = 0; k < pairs; k++)
+            {
+                data[k * pairStride] *= evenFactor;
+                data[k * pairStride + stride] *= oddFactor;
+            }
+            if (Scheme.evenShift != 0)
+                RotateLeft(data, pairs, pairStride, direction * Scheme.evenShift);
+            if (Scheme.oddShift != 0)
+                RotateLeft(data + stride, pairs, pairStride, direction * Scheme.oddShift);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,245 @@
+#pragma once
+#ifndef NPY_WRITER_H
+#define NPY_WRITER_H
+
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace SignalProcessing
+{
+    // Двоичный вывод массивов в формате NumPy: .npy (формат 1.0) и .npz (ZIP из .npy без сжатия).
+    // Данные пишутся как лежат в памяти (little-endian), np.load читает их без разбора текста;
+    // отдельный .npy открывается и через np.load(path, mmap_mode='r')
+    template <typename T>
+    struct NpyDtype;
+
+    template <>
+    struct NpyDtype<double> { static const char* Descr() { return "<f8"; } };
+
+    template <>
+    struct NpyDtype<std::complex<double>> { static const char* Descr() { return "<c16"; } };
+
+    template <>
+    struct NpyDtype<int> { static const char* Descr() { return "<i4"; } };
+
+    template <>
+    struct NpyDtype<long long> { static const char* Descr() { return "<i8"; } };
+
+    namespace Npy
+    {
+        // magic, версия 1.0, длина словаря и сам словарь; словарь дополняется пробелами
+        // до кратности 64 байтам, чтобы данные за заголовком были выровнены
+        inline std::string BuildHeader(const char* descr, size_t count)
+        {
+            std::string dictionary = std::string("{'descr': '") + descr +
+                "', 'fortran_order': False, 'shape': (" + std::to_string(count) + ",), }";
+
+            const size_t prefixSize = 10;
+            size_t total = prefixSize + dictionary.size() + 1;
+            dictionary.append((64 - total % 64) % 64, ' ');
+            dictionary.push_back('\n');
+
+            std::string header("\x93NUMPY\x01\x00", 8);
+            header.push_back(char(dictionary.size() & 0xFF));
+            header.push_back(char((dictionary.size() >> 8) & 0xFF));
+            return header + dictionary;
+        }
+
+        template <typename T>
+        void Save(const std::string& path, const std::vector<T>& values)
+        {
+            std::ofstream file(path, std::ios::binary);
+            if (!file.is_open())
+                throw std::runtime_error("Не удалось открыть файл " + path);
+
+            std::string header = BuildHeader(NpyDtype<T>::Descr(), values.size());
+            file.write(header.data(), header.size());
+            file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        }
+
+        inline uint32_t UpdateCrc32(uint32_t crc, const char* data, size_t size)
+        {
+            static const std::array<uint32_t, 256> table = []()
+            {
+                std::array<uint32_t, 256> result{};
+                for (uint32_t n = 0; n < 256; n++)
+                {
+                    uint32_t c = n;
+                    for (int k = 0; k < 8; k++)
+                        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    result[n] = c;
+                }
+                return result;
+            }();
+
+            crc = ~crc;
+            for (size_t i = 0; i < size; i++)
+                crc = table[(crc ^ (unsigned char)data[i]) & 0xFF] ^ (crc >> 8);
+            return ~crc;
+        }
+    }
+
+    // Архив .npz: каждый Add дописывает член "<name>.npy" методом stored (без сжатия),
+    // Close записывает центральный каталог. Без ZIP64: архив ограничен 4 ГБ и 65535 массивами.
+    // Члены архива np.load читает копированием, отображение в память доступно только для .npy
+    class NpzArchive
+    {
+    private:
+        struct Entry
+        {
+            std::string name;
+            uint32_t crc;
+            uint32_t size;
+            uint32_t offset;
+        };
+
+        std::ofstream file;
+        std::vector<Entry> entries;
+        uint64_t position;
+        bool closed;
+
+        // Дата 1980-01-01 в формате DOS: нулевая дата некорректна для части распаковщиков
+        static constexpr uint16_t DOS_DATE = (1 << 5) | 1;
+        static constexpr uint64_t MAX_ARCHIVE_SIZE = 0xFFFFFFFFu;
+
+    public:
+        explicit NpzArchive(const std::string& path)
+            : file(path, std::ios::binary), position(0), closed(false)
+        {
+            if (!file.is_open())
+                throw std::runtime_error("Не удалось открыть файл " + path);
+        }
+
+        ~NpzArchive()
+        {
+            // Деструктор не бросает исключений: ошибки записи каталога видны только через Close
+            try
+            {
+                Close();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        NpzArchive(const NpzArchive&) = delete;
+        NpzArchive& operator=(const NpzArchive&) = delete;
+
+        // name - ключ массива в np.load(...)[name]
+        template <typename T>
+        void Add(const std::string& name, const std::vector<T>& values)
+        {
+            if (closed)
+                throw std::runtime_error("Архив .npz уже закрыт");
+            if (entries.size() == 0xFFFF)
+                throw std::runtime_error("Архив .npz без ZIP64 вмещает не более 65535 массивов");
+
+            std::string header = Npy::BuildHeader(NpyDtype<T>::Descr(), values.size());
+            const char* data = reinterpret_cast<const char*>(values.data());
+            uint64_t dataSize = values.size() * sizeof(T);
+            uint64_t memberSize = header.size() + dataSize;
+
+            Entry entry;
+            entry.name = name + ".npy";
+            if (position + 30 + entry.name.size() + memberSize > MAX_ARCHIVE_SIZE)
+                throw std::runtime_error("Архив .npz без ZIP64 не может превышать 4 ГБ");
+
+            entry.crc = Npy::UpdateCrc32(Npy::UpdateCrc32(0, header.data(), header.size()), data, dataSize);
+            entry.size = (uint32_t)memberSize;
+            entry.offset = (uint32_t)position;
+
+            // Локальный заголовок: сигнатура, версия 2.0, флаги, метод 0 (stored), время, дата,
+            // CRC-32, сжатый и исходный размеры, длина имени, длина доп. поля
+            Put32(0x04034B50);
+            Put16(20);
+            Put16(0);
+            Put16(0);
+            Put16(0);
+            Put16(DOS_DATE);
+            Put32(entry.crc);
+            Put32(entry.size);
+            Put32(entry.size);
+            Put16((uint16_t)entry.name.size());
+            Put16(0);
+            PutBytes(entry.name.data(), entry.name.size());
+            PutBytes(header.data(), header.size());
+            PutBytes(data, dataSize);
+
+            entries.push_back(std::move(entry));
+        }
+
+        void Close()
+        {
+            if (closed)
+                return;
+            closed = true;
+
+            uint64_t directoryOffset = position;
+            for (const Entry& entry : entries)
+            {
+                Put32(0x02014B50);
+                Put16(20);
+                Put16(20);
+                Put16(0);
+                Put16(0);
+                Put16(0);
+                Put16(DOS_DATE);
+                Put32(entry.crc);
+                Put32(entry.size);
+                Put32(entry.size);
+                Put16((uint16_t)entry.name.size());
+                Put16(0); // доп. поле
+                Put16(0); // комментарий
+                Put16(0); // номер диска
+                Put16(0); // внутренние атрибуты
+                Put32(0); // внешние атрибуты
+                Put32(entry.offset);
+                PutBytes(entry.name.data(), entry.name.size());
+            }
+            uint64_t directorySize = position - directoryOffset;
+            if (position + 22 > MAX_ARCHIVE_SIZE)
+                throw std::runtime_error("Архив .npz без ZIP64 не может превышать 4 ГБ");
+
+            Put32(0x06054B50);
+            Put16(0);
+            Put16(0);
+            Put16((uint16_t)entries.size());
+            Put16((uint16_t)entries.size());
+            Put32((uint32_t)directorySize);
+            Put32((uint32_t)directoryOffset);
+            Put16(0);
+
+            file.close();
+            if (file.fail())
+                throw std::runtime_error("Ошибка записи архива .npz");
+        }
+
+    private:
+        void PutBytes(const char* data, uint64_t size)
+        {
+            file.write(data, (std::streamsize)size);
+            position += size;
+        }
+
+        // Поля ZIP - little-endian независимо от платформы
+        void Put16(uint16_t value)
+        {
+            char bytes[2] = { char(value & 0xFF), char(value >> 8) };
+            PutBytes(bytes, 2);
+        }
+
+        void Put32(uint32_t value)
+        {
+            char bytes[4] = { char(value & 0xFF), char((value >> 8) & 0xFF),
+                char((value >> 16) & 0xFF), char((value >> 24) & 0xFF) };
+            PutBytes(bytes, 4);
+        }
+    };
+}
+
+#endif
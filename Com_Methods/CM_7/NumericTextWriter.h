@@ -0,0 +1,171 @@
+#pragma once
+#ifndef NUMERIC_TEXT_WRITER_H
+#define NUMERIC_TEXT_WRITER_H
+
+#include <algorithm>
+#include <charconv>
+#include <complex>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace SignalProcessing
+{
+    // Буферизованный вывод чисел в текст (CSV и столбцы .txt) для CM_6, CM_7 и CM_8.
+    // Числа форматируются std::to_chars прямо в блок памяти: по умолчанию кратчайшая запись,
+    // которая читается обратно в то же double, либо фиксированная точность (Fixed).
+    // Файл пишется целыми блоками; остаток сбрасывается в Flush и в деструкторе.
+    // Как и прежние ofstream-писатели, при неудачном открытии файла вывод молча отбрасывается.
+    // Число длиннее MAX_NUMBER_CHARS (Fixed с большими значением и точностью) - исключение,
+    // строка при этом не меняется
+    class NumericTextWriter
+    {
+    private:
+        // Запас под одно число: кратчайшее double - до 24 символов, фиксированная запись
+        // больших значений длиннее, поэтому запас с избытком
+        static constexpr size_t MAX_NUMBER_CHARS = 352;
+
+        std::ofstream file;
+        std::vector<char> block;
+        size_t used;
+        char separator;
+        bool rowStarted;
+
+    public:
+        explicit NumericTextWriter(const std::string& path, char columnSeparator = ',', size_t blockSize = 1 << 20)
+            : file(path, std::ios::binary), block(blockSize < 2 * MAX_NUMBER_CHARS ? 2 * MAX_NUMBER_CHARS : blockSize),
+            used(0), separator(columnSeparator), rowStarted(false)
+        {
+        }
+
+        ~NumericTextWriter()
+        {
+            Flush();
+        }
+
+        NumericTextWriter(const NumericTextWriter&) = delete;
+        NumericTextWriter& operator=(const NumericTextWriter&) = delete;
+
+        bool IsOpen() const { return file.is_open(); }
+
+        // Произвольный текст (заголовок CSV), без разделителей столбцов
+        NumericTextWriter& Text(const std::string& text)
+        {
+            const char* data = text.data();
+            size_t remaining = text.size();
+            while (remaining > 0)
+            {
+                if (used == block.size())
+                    WriteBlock();
+                size_t portion = std::min(remaining, block.size() - used);
+                std::memcpy(block.data() + used, data, portion);
+                used += portion;
+                data += portion;
+                remaining -= portion;
+            }
+            return *this;
+        }
+
+        // Столбцы строки: разделитель ставится перед всеми столбцами, кроме первого
+        NumericTextWriter& Column(double value)
+        {
+            char* position = BeginColumn();
+            EndColumn(std::to_chars(position, position + MAX_NUMBER_CHARS, value));
+            return *this;
+        }
+
+        NumericTextWriter& Column(long long value)
+        {
+            char* position = BeginColumn();
+            EndColumn(std::to_chars(position, position + MAX_NUMBER_CHARS, value));
+            return *this;
+        }
+
+        NumericTextWriter& Column(int value)
+        {
+            return Column((long long)value);
+        }
+
+        // Комплексное значение - два столбца: вещественная и мнимая части
+        NumericTextWriter& Column(const std::complex<double>& value)
+        {
+            return Column(value.real()).Column(value.imag());
+        }
+
+        // precision знаков после запятой (как std::fixed << std::setprecision(precision))
+        NumericTextWriter& Fixed(double value, int precision)
+        {
+            char* position = BeginColumn();
+            EndColumn(std::to_chars(position, position + MAX_NUMBER_CHARS, value, std::chars_format::fixed, precision));
+            return *this;
+        }
+
+        NumericTextWriter& EndRow()
+        {
+            Reserve(1);
+            block[used++] = '\n';
+            rowStarted = false;
+            return *this;
+        }
+
+        // Ряды целиком: одно значение (real) или пара re, im (complex) в строке
+        NumericTextWriter& Series(const std::vector<double>& values)
+        {
+            for (double value : values)
+                Column(value).EndRow();
+            return *this;
+        }
+
+        NumericTextWriter& Series(const std::vector<std::complex<double>>& values)
+        {
+            for (const auto& value : values)
+                Column(value).EndRow();
+            return *this;
+        }
+
+        void Flush()
+        {
+            if (used > 0)
+                WriteBlock();
+            file.flush();
+        }
+
+    private:
+        void WriteBlock()
+        {
+            if (file.is_open())
+                file.write(block.data(), (std::streamsize)used);
+            used = 0;
+        }
+
+        void Reserve(size_t count)
+        {
+            if (block.size() - used < count)
+                WriteBlock();
+        }
+
+        // Число пишется за разделителем; used и rowStarted меняются только в EndColumn,
+        // после успешного форматирования
+        char* BeginColumn()
+        {
+            Reserve(MAX_NUMBER_CHARS + 1);
+            if (!rowStarted)
+                return block.data() + used;
+            block[used] = separator;
+            return block.data() + used + 1;
+        }
+
+        void EndColumn(std::to_chars_result result)
+        {
+            if (result.ec != std::errc())
+                throw std::runtime_error("Запись числа длиннее " + std::to_string(MAX_NUMBER_CHARS) + " символов");
+            used = result.ptr - block.data();
+            rowStarted = true;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <algorithm>
+#include "ThreadPool.h"
+
+namespace SignalProcessing
+{
+    namespace Parallel
+    {
+        inline int HardwareThreads()
+        {
+            return ThreadPool::HardwareThreads();
+        }
+
+        // Общий пул процесса: строчные и столбцовые проходы, транспонирование и задачи
+        // экспериментов выполняются одними и теми же долгоживущими потоками
+        inline ThreadPool& SharedPool()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        // Диапазон [begin, end) делится на непрерывные куски не короче minChunk, body(first, last)
+        // вызывается для каждого куска в вызывающем потоке или в потоке общего пула.
+        // Кусок целиком принадлежит одному потоку, поэтому рабочие буферы заводятся в body один раз;
+        // разбиение зависит только от длины, minChunk и maxWorkers, но не от того, кто выполняет куски.
+        // Исключение из любого куска пробрасывается вызывающему после завершения всех кусков.
+        // maxWorkers > 0 ограничивает число кусков (0 - по числу ядер)
+        template <typename Body>
+        void ForRange(int begin, int end, Body body, int minChunk = 1, int maxWorkers = 0)
+        {
+            int count = end - begin;
+            if (count <= 0)
+                return;
+
+            int available = maxWorkers > 0 ? maxWorkers : HardwareThreads();
+            int workers = std::min(available, std::max(1, count / std::max(1, minChunk)));
+            if (workers == 1)
+            {
+                body(begin, end);
+                return;
+            }
+
+            int chunk = (count + workers - 1) / workers;
+            int chunkCount = (count + chunk - 1) / chunk;
+            auto runChunk = [&body, begin, end, chunk](int index)
+            {
+                int first = begin + index * chunk;
+                body(first, std::min(end, first + chunk));
+            };
+            SharedPool().RunChunks(chunkCount, runChunk);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,151 @@
+#include "PolyphaseResampler.h"
+#include "MathConstants.h"
+#include "ComplexKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace SignalProcessing
+{
+    // Модифицированная функция Бесселя I0 (ряд до машинной точности)
+    static double BesselI0(double x)
+    {
+        double sum = 1.0, term = 1.0;
+        double halfX = x / 2.0;
+        for (int k = 1; term > 1e-17 * sum; k++)
+        {
+            term *= (halfX / k) * (halfX / k);
+            sum += term;
+        }
+        return sum;
+    }
+
+    static void ReduceFactors(int& up, int& down)
+    {
+        if (up < 1 || down < 1)
+            throw std::runtime_error("Коэффициенты передискретизации должны быть положительными");
+
+        int divisor = std::gcd(up, down);
+        up /= divisor;
+        down /= divisor;
+    }
+
+    template <typename Sample>
+    void BasicPolyphaseResampler<Sample>::DesignAntiAliasFilter(int up, int down, int filterHalfLength,
+        double kaiserBeta, std::vector<double>& filter)
+    {
+        ReduceFactors(up, down);
+
+        int maxFactor = std::max(up, down);
+        int halfLength = filterHalfLength * maxFactor;
+        int length = 2 * halfLength + 1;
+        double cutoff = 1.0 / maxFactor; // доля частоты Найквиста повышенной частоты
+
+        filter.resize(length);
+        double windowNorm = BesselI0(kaiserBeta);
+        for (int k = 0; k < length; k++)
+        {
+            double t = k - halfLength;
+            double sinc = (t == 0.0) ? 1.0 : std::sin(Constants::PI * cutoff * t) / (Constants::PI * cutoff * t);
+            double ratio = t / halfLength;
+            double window = BesselI0(kaiserBeta * std::sqrt(std::max(0.0, 1.0 - ratio * ratio))) / windowNorm;
+            filter[k] = up * cutoff * sinc * window;
+        }
+    }
+
+    template <typename Sample>
+    BasicPolyphaseResampler<Sample>::BasicPolyphaseResampler(int up, int down, int filterHalfLength, double kaiserBeta)
+        : upFactor(up), downFactor(down)
+    {
+        ReduceFactors(upFactor, downFactor);
+        DesignAntiAliasFilter(upFactor, downFactor, filterHalfLength, kaiserBeta, prototypeFilter);
+        BuildPhases();
+    }
+
+    template <typename Sample>
+    BasicPolyphaseResampler<Sample>::BasicPolyphaseResampler(int up, int down, const std::vector<double>& filter)
+        : upFactor(up), downFactor(down), prototypeFilter(filter)
+    {
+        ReduceFactors(upFactor, downFactor);
+        if (prototypeFilter.empty())
+            throw std::runtime_error("Фильтр передискретизации не может быть пустым");
+        BuildPhases();
+    }
+
+    // Фаза p содержит отводы h[p], h[p + L], h[p + 2L], ...; хвост дополняется нулями до T * L
+    template <typename Sample>
+    void BasicPolyphaseResampler<Sample>::BuildPhases()
+    {
+        int length = (int)prototypeFilter.size();
+        tapsPerPhase = (length + upFactor - 1) / upFactor;
+        delay = (length - 1) / 2;
+
+        phaseFilters.assign(upFactor, std::vector<Sample>(tapsPerPhase, Sample(0.0)));
+        for (int p = 0; p < upFactor; p++)
+        {
+            for (int j = 0; j < tapsPerPhase; j++)
+            {
+                int k = p + j * upFactor;
+                if (k < length)
+                    phaseFilters[p][tapsPerPhase - 1 - j] = Sample(prototypeFilter[k]);
+            }
+        }
+
+        Reset();
+    }
+
+    template <typename Sample>
+    void BasicPolyphaseResampler<Sample>::Reset()
+    {
+        history.assign(tapsPerPhase - 1, Sample(0.0));
+        nextTime = 0;
+    }
+
+    // y[m] = sum_j h[p + jL] * x[i - j], где t = mM = iL + p
+    template <typename Sample>
+    void BasicPolyphaseResampler<Sample>::Process(const std::vector<Sample>& input, std::vector<Sample>& output)
+    {
+        int count = (int)input.size();
+        int offset = tapsPerPhase - 1;
+
+        extended.resize(offset + count);
+        std::copy(history.begin(), history.end(), extended.begin());
+        std::copy(input.begin(), input.end(), extended.begin() + offset);
+
+        long long blockTime = (long long)count * upFactor;
+        for (; nextTime < blockTime; nextTime += downFactor)
+        {
+            int inputIdx = (int)(nextTime / upFactor);
+            int phase = (int)(nextTime % upFactor);
+            output.push_back(Kernels::ConjugateDot(extended.data() + inputIdx,
+                phaseFilters[phase].data(), tapsPerPhase));
+        }
+
+        nextTime -= blockTime;
+        std::copy(extended.end() - offset, extended.end(), history.begin());
+    }
+
+    // Выход сдвинут на задержку фильтра, хвост досчитывается на нулевом входе
+    template <typename Sample>
+    void BasicPolyphaseResampler<Sample>::Resample(const std::vector<Sample>& input, std::vector<Sample>& output)
+    {
+        long long outputCount = ((long long)input.size() * upFactor + downFactor - 1) / downFactor;
+
+        Reset();
+        nextTime = delay;
+        output.clear();
+        output.reserve((size_t)outputCount);
+        Process(input, output);
+
+        std::vector<Sample> zeros(delay / upFactor + 1, Sample(0.0));
+        while ((long long)output.size() < outputCount)
+            Process(zeros, output);
+
+        output.resize((size_t)outputCount);
+        Reset();
+    }
+
+    template class BasicPolyphaseResampler<double>;
+    template class BasicPolyphaseResampler<std::complex<double>>;
+}
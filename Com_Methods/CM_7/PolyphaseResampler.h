@@ -0,0 +1,65 @@
+#pragma once
+#ifndef POLYPHASE_RESAMPLER_H
+#define POLYPHASE_RESAMPLER_H
+
+#include <vector>
+#include <complex>
+#include "SampleTraits.h"
+
+namespace SignalProcessing
+{
+    // Рациональная передискретизация в upFactor / downFactor раз полифазным фильтром:
+    // вставленные нули и отброшенные отсчёты не вычисляются, на каждый выходной отсчёт
+    // приходится одна фаза из tapsPerPhase отводов.
+    // Фильтр по умолчанию - ФНЧ sinc с окном Кайзера, срез 1 / (2 max(L, M)), усиление L.
+    template <typename Sample>
+    class BasicPolyphaseResampler
+    {
+    private:
+        int upFactor, downFactor;
+        int tapsPerPhase;
+        int delay; // групповая задержка фильтра в отсчётах повышенной частоты
+        std::vector<double> prototypeFilter;
+
+        // phaseFilters[p][T - 1 - j] = h[p + j * L] - фазы развёрнуты для ConjugateDot по окну входа
+        // (фильтр вещественный, сопряжение на него не действует)
+        std::vector<std::vector<Sample>> phaseFilters;
+
+        // Состояние потока: T - 1 последних входных отсчётов и момент следующего выхода
+        // (в отсчётах повышенной частоты от начала очередного блока)
+        std::vector<Sample> history;
+        std::vector<Sample> extended;
+        long long nextTime;
+
+    public:
+        // filterHalfLength - полудлина ФНЧ в единицах max(L, M)
+        BasicPolyphaseResampler(int up, int down, int filterHalfLength = 10, double kaiserBeta = 5.0);
+
+        // Собственный фильтр-прототип на повышенной частоте (усиление должно быть L)
+        BasicPolyphaseResampler(int up, int down, const std::vector<double>& filter);
+
+        int GetUpFactor() const { return upFactor; }
+        int GetDownFactor() const { return downFactor; }
+        const std::vector<double>& GetFilter() const { return prototypeFilter; }
+
+        // Весь буфер: задержка фильтра скомпенсирована, длина результата ceil(N * L / M)
+        void Resample(const std::vector<Sample>& input, std::vector<Sample>& output);
+
+        // Потоковый режим: состояние фильтра сохраняется между блоками, выход дописывается в output
+        void Process(const std::vector<Sample>& input, std::vector<Sample>& output);
+
+        void Reset();
+
+        // ФНЧ с окном Кайзера для коэффициентов up / down
+        static void DesignAntiAliasFilter(int up, int down, int filterHalfLength, double kaiserBeta,
+            std::vector<double>& filter);
+
+    private:
+        void BuildPhases();
+    };
+
+    using PolyphaseResampler = BasicPolyphaseResampler<std::complex<double>>;
+    using RealPolyphaseResampler = BasicPolyphaseResampler<double>;
+}
+
+#endif
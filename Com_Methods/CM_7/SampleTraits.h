@@ -0,0 +1,76 @@
+#pragma once
+#ifndef SAMPLE_TRAITS_H
+#define SAMPLE_TRAITS_H
+
+#include <complex>
+#include <vector>
+
+namespace SignalProcessing
+{
+    // Операции над отсчётом сигнала: double для вещественных данных,
+    // std::complex<double> - только там, где он действительно нужен (фильтр Шеннона)
+    template <typename Sample>
+    struct SampleTraits;
+
+    template <>
+    struct SampleTraits<double>
+    {
+        static constexpr bool IsComplex = false;
+
+        static double Conjugate(double value) { return value; }
+        static double Real(double value) { return value; }
+        static double Imag(double) { return 0.0; }
+        static double Compose(double realPart, double) { return realPart; }
+    };
+
+    template <>
+    struct SampleTraits<std::complex<double>>
+    {
+        static constexpr bool IsComplex = true;
+
+        static std::complex<double> Conjugate(const std::complex<double>& value) { return std::conj(value); }
+        static double Real(const std::complex<double>& value) { return value.real(); }
+        static double Imag(const std::complex<double>& value) { return value.imag(); }
+        static std::complex<double> Compose(double realPart, double imagPart) { return std::complex<double>(realPart, imagPart); }
+    };
+
+    // Приведение отсчёта к типу Target; в вещественный тип переходит только вещественная часть
+    template <typename Target>
+    inline Target ConvertSample(double value)
+    {
+        return Target(value);
+    }
+
+    template <typename Target>
+    inline Target ConvertSample(const std::complex<double>& value)
+    {
+        return SampleTraits<Target>::Compose(value.real(), value.imag());
+    }
+
+    // Перевод в комплексный буфер (для БПФ) и обратно
+    inline void LoadSamples(const std::vector<double>& source, std::vector<std::complex<double>>& target)
+    {
+        target.assign(source.begin(), source.end());
+    }
+
+    inline void LoadSamples(const std::vector<std::complex<double>>& source, std::vector<std::complex<double>>& target)
+    {
+        target = source;
+    }
+
+    // Результат копируется, а не забирается обменом: source обычно буфер арены,
+    // и его ёмкость должна остаться в арене
+    inline void StoreSamples(std::vector<std::complex<double>>& source, std::vector<double>& target)
+    {
+        target.resize(source.size());
+        for (int i = 0; i < (int)source.size(); i++)
+            target[i] = source[i].real();
+    }
+
+    inline void StoreSamples(std::vector<std::complex<double>>& source, std::vector<std::complex<double>>& target)
+    {
+        target.assign(source.begin(), source.end());
+    }
+}
+
+#endif
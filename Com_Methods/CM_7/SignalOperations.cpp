@@ -1,61 +1,94 @@
 #include "SignalOperations.h"
-#include <cmath>
+#include "SignalViews.h"
+#include "ComplexKernels.h"
+#include "PolyphaseResampler.h"
 
 namespace SignalProcessing
 {
+    template <typename Sample>
     void SignalOperations::PerformCircularShift(int shiftAmount,
-        const std::vector<std::complex<double>>& data,
-        std::vector<std::complex<double>>& result)
+        const std::vector<Sample>& data,
+        std::vector<Sample>& result)
     {
-        int size = (int)data.size();
-        result.assign(size, std::complex<double>(0.0, 0.0));
-
-        for (int i = 0; i < size; i++)
-        {
-            int shiftedIndex = i - shiftAmount;
-            if (shiftedIndex < 0) shiftedIndex += size;
-            result[i] = data[shiftedIndex];
-        }
+        Views::Materialize(Views::Shift(Views::View(data), shiftAmount), result);
     }
 
+    template <typename Sample>
     void SignalOperations::ApplyDownsampling(int level,
-        const std::vector<std::complex<double>>& data,
-        std::vector<std::complex<double>>& result)
+        const std::vector<Sample>& data,
+        std::vector<Sample>& result)
     {
-        int factor = (int)std::pow(2.0, level);
-        int newSize = (int)data.size() / factor;
-        result.assign(newSize, std::complex<double>(0.0, 0.0));
-
-        for (int i = 0; i < newSize; i++)
-            result[i] = data[i * factor];
+        int newSize = (int)data.size() >> level;
+        result.resize(newSize);
+        Kernels::Gather(data.data(), 1 << level, result.data(), newSize);
     }
 
+    template <typename Sample>
     void SignalOperations::ApplyUpsampling(int level,
-        const std::vector<std::complex<double>>& data,
-        std::vector<std::complex<double>>& result)
+        const std::vector<Sample>& data,
+        std::vector<Sample>& result)
+    {
+        // Нули заполняются одним проходом, затем отсчёты раскладываются с шагом 2^level
+        int size = (int)data.size();
+        result.assign(size << level, Sample(0.0));
+        Kernels::Scatter(data.data(), result.data(), 1 << level, size);
+    }
+
+    template <typename Sample>
+    Sample SignalOperations::ComputeDotProduct(const std::vector<Sample>& vec1,
+        const std::vector<Sample>& vec2)
     {
-        int factor = (int)std::pow(2.0, level);
-        int newSize = (int)data.size() * factor;
-        result.assign(newSize, std::complex<double>(0.0, 0.0));
-
-        for (int i = 0; i < newSize; i++)
-        {
-            if (i % factor == 0)
-                result[i] = data[i / factor];
-            else
-                result[i] = std::complex<double>(0.0, 0.0);
-        }
+        return Kernels::ConjugateDot(vec1.data(), vec2.data(), (int)vec1.size());
     }
 
-    std::complex<double> SignalOperations::ComputeDotProduct(const std::vector<std::complex<double>>& vec1,
-        const std::vector<std::complex<double>>& vec2)
+    template <typename Sample>
+    Sample SignalOperations::ComputeShiftedDotProduct(int shiftAmount,
+        const std::vector<Sample>& vec1,
+        const std::vector<Sample>& vec2)
     {
         int size = (int)vec1.size();
-        std::complex<double> result(0.0, 0.0);
+        int shift = shiftAmount % size;
+        if (shift < 0) shift += size;
+
+        // vec2 сдвинут на shift: индексы i < shift берутся из хвоста vec2
+        return Kernels::ConjugateDot(vec1.data(), vec2.data() + size - shift, shift)
+            + Kernels::ConjugateDot(vec1.data() + shift, vec2.data(), size - shift);
+    }
 
-        for (int i = 0; i < size; i++)
-            result += vec1[i] * std::conj(vec2[i]);
+    template <typename Sample>
+    void SignalOperations::AccumulateShifted(int shiftAmount, Sample coefficient,
+        const std::vector<Sample>& data,
+        std::vector<Sample>& result)
+    {
+        int size = (int)data.size();
+        int shift = shiftAmount % size;
+        if (shift < 0) shift += size;
+
+        Kernels::Axpy(coefficient, data.data() + size - shift, result.data(), shift);
+        Kernels::Axpy(coefficient, data.data(), result.data() + shift, size - shift);
+    }
 
-        return result;
+    template <typename Sample>
+    void SignalOperations::ApplyRationalResampling(int upFactor, int downFactor,
+        const std::vector<Sample>& data,
+        std::vector<Sample>& result)
+    {
+        BasicPolyphaseResampler<Sample> resampler(upFactor, downFactor);
+        resampler.Resample(data, result);
     }
+
+    // Явные инстанцирования: вещественный и комплексный тракты
+#define SIGNAL_OPERATIONS_INSTANTIATE(Sample) \
+    template void SignalOperations::PerformCircularShift<Sample>(int, const std::vector<Sample>&, std::vector<Sample>&); \
+    template void SignalOperations::ApplyDownsampling<Sample>(int, const std::vector<Sample>&, std::vector<Sample>&); \
+    template void SignalOperations::ApplyUpsampling<Sample>(int, const std::vector<Sample>&, std::vector<Sample>&); \
+    template Sample SignalOperations::ComputeDotProduct<Sample>(const std::vector<Sample>&, const std::vector<Sample>&); \
+    template Sample SignalOperations::ComputeShiftedDotProduct<Sample>(int, const std::vector<Sample>&, const std::vector<Sample>&); \
+    template void SignalOperations::AccumulateShifted<Sample>(int, Sample, const std::vector<Sample>&, std::vector<Sample>&); \
+    template void SignalOperations::ApplyRationalResampling<Sample>(int, int, const std::vector<Sample>&, std::vector<Sample>&);
+
+    SIGNAL_OPERATIONS_INSTANTIATE(double)
+    SIGNAL_OPERATIONS_INSTANTIATE(std::complex<double>)
+
+#undef SIGNAL_OPERATIONS_INSTANTIATE
 }
\ No newline at end of file
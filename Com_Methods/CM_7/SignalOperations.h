@@ -4,30 +4,59 @@
 
 #include <complex>
 #include <vector>
+#include "SampleTraits.h"
+#include "SignalViews.h"
 
 namespace SignalProcessing
 {
+    // Операции определены для double и std::complex<double> (см. SampleTraits.h).
+    // Методы записывают результат в вектор; без копирования те же операции
+    // доступны как представления Views::Shift / Downsample / Upsample (SignalViews.h)
     class SignalOperations
     {
     public:
         // ��������� ����������� ����� �������
+        template <typename Sample>
         void PerformCircularShift(int shiftAmount,
-            const std::vector<std::complex<double>>& data,
-            std::vector<std::complex<double>>& result);
+            const std::vector<Sample>& data,
+            std::vector<Sample>& result);
 
         // ��������� ������������ (downsampling)
+        template <typename Sample>
         void ApplyDownsampling(int level,
-            const std::vector<std::complex<double>>& data,
-            std::vector<std::complex<double>>& result);
+            const std::vector<Sample>& data,
+            std::vector<Sample>& result);
 
         // ��������� ������������ (upsampling)
+        template <typename Sample>
         void ApplyUpsampling(int level,
-            const std::vector<std::complex<double>>& data,
-            std::vector<std::complex<double>>& result);
+            const std::vector<Sample>& data,
+            std::vector<Sample>& result);
 
         // ��������� ��������� ������������
-        std::complex<double> ComputeDotProduct(const std::vector<std::complex<double>>& vec1,
-            const std::vector<std::complex<double>>& vec2);
+        template <typename Sample>
+        Sample ComputeDotProduct(const std::vector<Sample>& vec1,
+            const std::vector<Sample>& vec2);
+
+        // Скалярное произведение vec1 с циклически сдвинутым vec2 без копирования
+        template <typename Sample>
+        Sample ComputeShiftedDotProduct(int shiftAmount,
+            const std::vector<Sample>& vec1,
+            const std::vector<Sample>& vec2);
+
+        // result[i] += coefficient * data[i - shiftAmount] (циклический сдвиг индексами)
+        template <typename Sample>
+        void AccumulateShifted(int shiftAmount, Sample coefficient,
+            const std::vector<Sample>& data,
+            std::vector<Sample>& result);
+
+        // Передискретизация в upFactor / downFactor раз с антиалиасинговым фильтром
+        // (полифазная, см. PolyphaseResampler.h); в отличие от ApplyUpsampling / ApplyDownsampling
+        // нули не вставляются и отсчёты не отбрасываются после вычисления
+        template <typename Sample>
+        void ApplyRationalResampling(int upFactor, int downFactor,
+            const std::vector<Sample>& data,
+            std::vector<Sample>& result);
     };
 }
 
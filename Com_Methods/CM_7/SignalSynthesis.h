@@ -0,0 +1,350 @@
+#pragma once
+#ifndef SIGNAL_SYNTHESIS_H
+#define SIGNAL_SYNTHESIS_H
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "MathConstants.h"
+#include "ParallelFor.h"
+
+namespace SignalProcessing
+{
+    // Счётчиковый ГСЧ Philox4x32-10 (Salmon, Moraes, Dror, Shaw, 2011): случайные числа отсчёта
+    // получаются шифрованием его номера, общего состояния нет. Куски сигнала заполняются
+    // независимо и в любом порядке, а результат не зависит от разбиения на потоки
+    class Philox4x32
+    {
+    public:
+        using Block = std::array<uint32_t, 4>;
+
+    private:
+        static constexpr uint32_t MULTIPLIER_0 = 0xD2511F53u;
+        static constexpr uint32_t MULTIPLIER_1 = 0xCD9E8D57u;
+        static constexpr uint32_t KEY_STEP_0 = 0x9E3779B9u;
+        static constexpr uint32_t KEY_STEP_1 = 0xBB67AE85u;
+        static constexpr int ROUNDS = 10;
+
+        uint32_t key0, key1;
+
+    public:
+        explicit Philox4x32(uint64_t seed = 0)
+            : key0((uint32_t)seed), key1((uint32_t)(seed >> 32))
+        {
+        }
+
+        Block operator()(Block counter) const
+        {
+            uint32_t k0 = key0, k1 = key1;
+            for (int round = 0; round < ROUNDS; round++)
+            {
+                uint64_t product0 = (uint64_t)MULTIPLIER_0 * counter[0];
+                uint64_t product1 = (uint64_t)MULTIPLIER_1 * counter[2];
+                counter = { (uint32_t)(product1 >> 32) ^ counter[1] ^ k0, (uint32_t)product1,
+                    (uint32_t)(product0 >> 32) ^ counter[3] ^ k1, (uint32_t)product0 };
+                k0 += KEY_STEP_0;
+                k1 += KEY_STEP_1;
+            }
+            return counter;
+        }
+
+        // Две независимые равномерные величины в [0, 1) (53 бита) для отсчёта index потока stream
+        void Uniform2(uint64_t index, uint32_t stream, double& first, double& second) const
+        {
+            Block bits = (*this)({ (uint32_t)index, (uint32_t)(index >> 32), stream, 0u });
+            first = ToUnit(bits[0], bits[1]);
+            second = ToUnit(bits[2], bits[3]);
+        }
+
+    private:
+        static double ToUnit(uint32_t high, uint32_t low)
+        {
+            return (double)((((uint64_t)high << 32) | low) >> 11) * 0x1.0p-53;
+        }
+    };
+
+    // Синтез тестовых сигналов длины N: сумма слагаемых (постоянная, тон, линейный ЛЧМ, шум),
+    // у каждого свои ворота - набор интервалов, вне которых слагаемое равно нулю.
+    // Частоты задаются в периодах на длину сигнала, как omega в z(j) = cos(2 pi omega j / N + phi).
+    //
+    // Сигнал заполняется блоками по BLOCK_SIZE отсчётов, блоки делятся между потоками.
+    // Тон в блоке с началом j0 считается как A (cos(t0) C[k] - sin(t0) S[k]), где t0 - фаза в j0,
+    // а C, S - общие для всех блоков таблицы cos / sin набега фазы за k отсчётов: цикл без
+    // зависимостей векторизуется. Шум берёт числа Philox по номеру отсчёта и номеру шумового
+    // слагаемого. Значение отсчёта зависит только от его номера, поэтому сигнал совпадает
+    // бит в бит при любом числе потоков
+    class SignalSynthesizer
+    {
+    public:
+        // Полуинтервал номеров отсчётов [begin, end)
+        struct Interval
+        {
+            long long begin;
+            long long end;
+        };
+
+        // Непересекающиеся интервалы; пустые ворота - слагаемое действует на всём сигнале
+        using Gate = std::vector<Interval>;
+
+        static constexpr int BLOCK_SIZE = 64;
+
+    private:
+        // Меньше блоков на поток не даём: запуск потока дороже их заполнения
+        static constexpr int MIN_BLOCKS_PER_THREAD = 256;
+
+        enum class TermKind
+        {
+            Constant,
+            Tone,
+            Chirp,
+            UniformNoise,
+            GaussianNoise
+        };
+
+        struct Term
+        {
+            TermKind kind;
+            double amplitude;      // значение постоянной, амплитуда, ширина интервала или СКО шума
+            double offset;         // нижняя граница равномерного шума
+            double frequency;      // частота тона, начальная частота ЛЧМ
+            double endFrequency;   // конечная частота ЛЧМ
+            double phase;
+            uint32_t stream;       // номер потока Philox для шумовых слагаемых
+            Gate gate;
+        };
+
+        Philox4x32 generator;
+        std::vector<Term> terms;
+        uint32_t noiseStreams;
+        int threadCount;
+
+    public:
+        explicit SignalSynthesizer(uint64_t seed = 0)
+            : generator(seed), noiseStreams(0), threadCount(0)
+        {
+        }
+
+        // 0 - по числу ядер; на результат не влияет
+        void SetThreadCount(int threads) { threadCount = threads; }
+
+        SignalSynthesizer& AddConstant(double value, Gate gate = Gate())
+        {
+            return AddTerm(TermKind::Constant, value, 0.0, 0.0, 0.0, 0.0, std::move(gate));
+        }
+
+        // amplitude * cos(2 pi frequency j / N + phase)
+        SignalSynthesizer& AddTone(double amplitude, double frequency, double phase = 0.0, Gate gate = Gate())
+        {
+            return AddTerm(TermKind::Tone, amplitude, 0.0, frequency, 0.0, phase, std::move(gate));
+        }
+
+        // Частота линейно меняется от startFrequency в j = 0 до endFrequency в j = N:
+        // amplitude * cos(2 pi (f0 j + (f1 - f0) j^2 / (2N)) / N + phase)
+        SignalSynthesizer& AddChirp(double amplitude, double startFrequency, double endFrequency,
+            double phase = 0.0, Gate gate = Gate())
+        {
+            return AddTerm(TermKind::Chirp, amplitude, 0.0, startFrequency, endFrequency, phase, std::move(gate));
+        }
+
+        // Равномерный шум на [low, high)
+        SignalSynthesizer& AddUniformNoise(double low, double high, Gate gate = Gate())
+        {
+            return AddTerm(TermKind::UniformNoise, high - low, low, 0.0, 0.0, 0.0, std::move(gate));
+        }
+
+        // Нормальный шум N(0, deviation^2), преобразование Бокса - Мюллера
+        SignalSynthesizer& AddGaussianNoise(double deviation, Gate gate = Gate())
+        {
+            return AddTerm(TermKind::GaussianNoise, deviation, 0.0, 0.0, 0.0, 0.0, std::move(gate));
+        }
+
+        // Sample = double или std::complex<double> (мнимая часть нулевая)
+        template <typename Sample>
+        void Generate(size_t length, std::vector<Sample>& signal) const
+        {
+            size_t blockCount = (length + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            if (blockCount > (size_t)INT_MAX)
+                throw std::runtime_error("Слишком длинный сигнал для синтеза");
+
+            signal.resize(length);
+            if (length == 0)
+                return;
+
+            // Таблицы cos / sin за k = 0..BLOCK_SIZE-1 отсчётов от начала блока: набег фазы тона
+            // и квадратичная часть фазы ЛЧМ - обе не зависят от блока
+            double N = (double)length;
+            std::vector<std::vector<double>> phaseTables(terms.size());
+            for (size_t t = 0; t < terms.size(); t++)
+            {
+                const Term& term = terms[t];
+                if (term.kind != TermKind::Tone && term.kind != TermKind::Chirp)
+                    continue;
+                phaseTables[t].resize(2 * BLOCK_SIZE);
+                for (int k = 0; k < BLOCK_SIZE; k++)
+                {
+                    double cycles = (term.kind == TermKind::Tone) ? term.frequency * k : ChirpRate(term, N) * k * k;
+                    double angle = Constants::TWO_PI * ReduceCycles(cycles, N) / N;
+                    phaseTables[t][k] = std::cos(angle);
+                    phaseTables[t][BLOCK_SIZE + k] = std::sin(angle);
+                }
+            }
+
+            Parallel::ForRange(0, (int)blockCount, [&](int firstBlock, int lastBlock)
+            {
+                double sum[BLOCK_SIZE];
+                double values[BLOCK_SIZE];
+                for (int block = firstBlock; block < lastBlock; block++)
+                {
+                    long long start = (long long)block * BLOCK_SIZE;
+                    int count = (int)std::min<long long>(BLOCK_SIZE, (long long)length - start);
+
+                    std::fill(sum, sum + count, 0.0);
+                    for (size_t t = 0; t < terms.size(); t++)
+                        AccumulateTerm(terms[t], phaseTables[t], length, start, count, values, sum);
+
+                    for (int k = 0; k < count; k++)
+                        signal[start + k] = Sample(sum[k]);
+                }
+            }, MIN_BLOCKS_PER_THREAD, threadCount);
+        }
+
+    private:
+        SignalSynthesizer& AddTerm(TermKind kind, double amplitude, double offset, double frequency,
+            double endFrequency, double phase, Gate gate)
+        {
+            Term term{ kind, amplitude, offset, frequency, endFrequency, phase, 0u, std::move(gate) };
+            if (kind == TermKind::UniformNoise || kind == TermKind::GaussianNoise)
+                term.stream = noiseStreams++;
+            terms.push_back(std::move(term));
+            return *this;
+        }
+
+        // Число периодов по модулю N: фаза остаётся точной и для больших j
+        static double ReduceCycles(double cycles, double length)
+        {
+            return cycles - length * std::floor(cycles / length);
+        }
+
+        // Фаза ЛЧМ в периодах: f0 j + rate j^2
+        static double ChirpRate(const Term& term, double length)
+        {
+            return (term.endFrequency - term.frequency) / (2.0 * length);
+        }
+
+        // Значения слагаемого на отсчётах start..start+count-1 прибавляются к sum внутри ворот
+        void AccumulateTerm(const Term& term, const std::vector<double>& phaseTable, size_t length,
+            long long start, int count, double* values, double* sum) const
+        {
+            long long end = start + count;
+            if (!term.gate.empty())
+            {
+                bool touched = false;
+                for (const Interval& interval : term.gate)
+                    touched = touched || (interval.begin < end && interval.end > start);
+                if (!touched)
+                    return;
+            }
+
+            double N = (double)length;
+            switch (term.kind)
+            {
+            case TermKind::Constant:
+                std::fill(values, values + count, term.amplitude);
+                break;
+
+            case TermKind::Tone:
+            {
+                double startAngle = Constants::TWO_PI * ReduceCycles(term.frequency * (double)start, N) / N + term.phase;
+                double c = term.amplitude * std::cos(startAngle);
+                double s = term.amplitude * std::sin(startAngle);
+                const double* cosTable = phaseTable.data();
+                const double* sinTable = phaseTable.data() + BLOCK_SIZE;
+                for (int k = 0; k < count; k++)
+                    values[k] = c * cosTable[k] - s * sinTable[k];
+                break;
+            }
+
+            // Фаза в j0 + k: t0 + w k + Q[k], где w = 2 pi (f0 + 2 rate j0) / N - частота блока,
+            // Q[k] = 2 pi rate k^2 / N - общая таблица. exp(i w k) собирается из exp(i w 8a) и exp(i w b)
+            // при k = 8a + b: на блок 16 пар cos / sin вместо 64
+            case TermKind::Chirp:
+            {
+                const int FINE = 8;
+                double rate = ChirpRate(term, N);
+                double j0 = (double)start;
+                double startAngle = Constants::TWO_PI * (ReduceCycles(term.frequency * j0, N) +
+                    ReduceCycles(rate * j0 * j0, N)) / N + term.phase;
+                double step = Constants::TWO_PI * ReduceCycles(term.frequency + 2.0 * rate * j0, N) / N;
+
+                double coarseCos[BLOCK_SIZE / FINE], coarseSin[BLOCK_SIZE / FINE];
+                double fineCos[FINE], fineSin[FINE];
+                for (int a = 0; a < BLOCK_SIZE / FINE; a++)
+                {
+                    coarseCos[a] = term.amplitude * std::cos(startAngle + step * (FINE * a));
+                    coarseSin[a] = term.amplitude * std::sin(startAngle + step * (FINE * a));
+                }
+                for (int b = 0; b < FINE; b++)
+                {
+                    fineCos[b] = std::cos(step * b);
+                    fineSin[b] = std::sin(step * b);
+                }
+
+                const double* cosTable = phaseTable.data();
+                const double* sinTable = phaseTable.data() + BLOCK_SIZE;
+                for (int a = 0; a * FINE < count; a++)
+                {
+                    int first = a * FINE;
+                    int width = std::min(FINE, count - first);
+                    for (int b = 0; b < width; b++)
+                    {
+                        double re = coarseCos[a] * fineCos[b] - coarseSin[a] * fineSin[b];
+                        double im = coarseCos[a] * fineSin[b] + coarseSin[a] * fineCos[b];
+                        values[first + b] = re * cosTable[first + b] - im * sinTable[first + b];
+                    }
+                }
+                break;
+            }
+
+            case TermKind::UniformNoise:
+                for (int k = 0; k < count; k++)
+                {
+                    double u, unused;
+                    generator.Uniform2((uint64_t)(start + k), term.stream, u, unused);
+                    values[k] = term.offset + term.amplitude * u;
+                }
+                break;
+
+            case TermKind::GaussianNoise:
+                for (int k = 0; k < count; k++)
+                {
+                    double u1, u2;
+                    generator.Uniform2((uint64_t)(start + k), term.stream, u1, u2);
+                    values[k] = term.amplitude * std::sqrt(-2.0 * std::log(1.0 - u1)) * std::cos(Constants::TWO_PI * u2);
+                }
+                break;
+            }
+
+            if (term.gate.empty())
+            {
+                for (int k = 0; k < count; k++)
+                    sum[k] += values[k];
+                return;
+            }
+
+            for (const Interval& interval : term.gate)
+            {
+                long long first = std::max(interval.begin, start);
+                long long last = std::min(interval.end, end);
+                for (long long j = first; j < last; j++)
+                    sum[j - start] += values[j - start];
+            }
+        }
+    };
+}
+
+#endif
@@ -22,6 +22,12 @@ namespace SignalProcessing
         void ComputeConvolution(const std::vector<std::complex<double>>& vector1,
             const std::vector<std::complex<double>>& vector2,
             std::vector<std::complex<double>>& result);
+
+        // Линейная свёртка signal * filter длины N + L - 1; способ (прямая или overlap-save)
+        // выбирается по длине фильтра. Для многократного применения одного фильтра - ConvolutionEngine
+        void ComputeLinearConvolution(const std::vector<std::complex<double>>& signal,
+            const std::vector<std::complex<double>>& filter,
+            std::vector<std::complex<double>>& result);
     };
 }
 
@@ -0,0 +1,154 @@
+#pragma once
+#ifndef SIGNAL_VIEWS_H
+#define SIGNAL_VIEWS_H
+
+#include <vector>
+#include "SampleTraits.h"
+
+namespace SignalProcessing
+{
+    // Ленивые представления сигнала: сдвиг, прореживание и повышение частоты без копирования.
+    // Представления хранят источник по значению и вычисляют отсчёт при обращении, поэтому
+    // цепочка Dot(Downsample(Shift(View(x), s), 1), View(f)) сводится к одному циклу без выделения памяти.
+    // Источник-вектор должен жить дольше представления.
+    namespace Views
+    {
+        template <typename Sample>
+        class VectorView
+        {
+        public:
+            typedef Sample value_type;
+
+            explicit VectorView(const std::vector<Sample>& data)
+                : values(data.data()), count((int)data.size()) {}
+
+            int size() const { return count; }
+            Sample operator[](int i) const { return values[i]; }
+
+        private:
+            const Sample* values;
+            int count;
+        };
+
+        // result[i] = source[i - shiftAmount] с циклическим переносом
+        template <typename Source>
+        class ShiftView
+        {
+        public:
+            typedef typename Source::value_type value_type;
+
+            ShiftView(const Source& source, int shiftAmount)
+                : source(source), count(source.size()), shift(0)
+            {
+                if (count > 0)
+                {
+                    shift = shiftAmount % count;
+                    if (shift < 0) shift += count;
+                }
+            }
+
+            int size() const { return count; }
+
+            value_type operator[](int i) const
+            {
+                int idx = i - shift;
+                if (idx < 0) idx += count;
+                return source[idx];
+            }
+
+        private:
+            Source source;
+            int count;
+            int shift;
+        };
+
+        // result[i] = source[i * 2^level]
+        template <typename Source>
+        class DownsampleView
+        {
+        public:
+            typedef typename Source::value_type value_type;
+
+            DownsampleView(const Source& source, int level)
+                : source(source), level(level) {}
+
+            int size() const { return source.size() >> level; }
+            value_type operator[](int i) const { return source[i << level]; }
+
+        private:
+            Source source;
+            int level;
+        };
+
+        // result[i] = source[i / 2^level] для i, кратных 2^level, иначе 0
+        template <typename Source>
+        class UpsampleView
+        {
+        public:
+            typedef typename Source::value_type value_type;
+
+            UpsampleView(const Source& source, int level)
+                : source(source), level(level), mask((1 << level) - 1) {}
+
+            int size() const { return source.size() << level; }
+
+            value_type operator[](int i) const
+            {
+                return (i & mask) ? value_type(0.0) : source[i >> level];
+            }
+
+        private:
+            Source source;
+            int level;
+            int mask;
+        };
+
+        template <typename Sample>
+        inline VectorView<Sample> View(const std::vector<Sample>& data)
+        {
+            return VectorView<Sample>(data);
+        }
+
+        template <typename Source>
+        inline ShiftView<Source> Shift(const Source& source, int shiftAmount)
+        {
+            return ShiftView<Source>(source, shiftAmount);
+        }
+
+        template <typename Source>
+        inline DownsampleView<Source> Downsample(const Source& source, int level)
+        {
+            return DownsampleView<Source>(source, level);
+        }
+
+        template <typename Source>
+        inline UpsampleView<Source> Upsample(const Source& source, int level)
+        {
+            return UpsampleView<Source>(source, level);
+        }
+
+        // sum_i a[i] * conj(b[i]) по длине a
+        template <typename SourceA, typename SourceB>
+        inline typename SourceA::value_type Dot(const SourceA& a, const SourceB& b)
+        {
+            typedef typename SourceA::value_type Sample;
+            Sample result(0.0);
+            int size = a.size();
+            for (int i = 0; i < size; i++)
+                result += a[i] * SampleTraits<Sample>::Conjugate(b[i]);
+            return result;
+        }
+
+        // Вычисление представления в вектор (с приведением типа отсчёта)
+        template <typename Source, typename Target>
+        inline void Materialize(const Source& source, std::vector<Target>& result)
+        {
+            int size = source.size();
+            result.resize(size);
+            for (int i = 0; i < size; i++)
+                result[i] = ConvertSample<Target>(source[i]);
+        }
+    }
+}
+
+#endif
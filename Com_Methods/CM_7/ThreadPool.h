@@ -0,0 +1,185 @@
+#pragma once
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace SignalProcessing
+{
+    // Пул потоков фиксированного размера. Submit ставит задачу в очередь и возвращает future
+    // с её результатом (исключение задачи пробрасывается из future::get).
+    // RunChunks - параллельный проход по кускам [0, chunkCount): куски разбирают вызывающий
+    // поток и свободные рабочие. Рабочие живут столько же, сколько пул, поэтому их
+    // thread_local-состояние (арены WorkspacePool, таблицы БПФ) сохраняется между проходами.
+    // Деструктор дожидается выполнения всех поставленных задач
+    class ThreadPool
+    {
+    private:
+        // Описание прохода лежит в стеке вызывающего RunChunks: проход не обращается к куче.
+        // Все поля, кроме invoke и context, меняются под mutex
+        struct ChunkRun
+        {
+            void (*invoke)(void* context, int chunk);
+            void* context;
+            int chunkCount;
+            int nextChunk;
+            int finishedChunks;
+            int helpers;            // рабочие, выполняющие куски этого прохода
+            std::exception_ptr error;
+        };
+
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable workAvailable, chunksFinished;
+        ChunkRun* openRun;          // проход с невыданными кусками; одновременно открыт только один
+        bool stopping;
+
+    public:
+        // threadCount <= 0 - по числу аппаратных потоков
+        explicit ThreadPool(int threadCount = 0)
+            : openRun(nullptr), stopping(false)
+        {
+            if (threadCount <= 0)
+                threadCount = HardwareThreads();
+
+            workers.reserve(threadCount);
+            for (int i = 0; i < threadCount; i++)
+                workers.emplace_back([this]() { WorkerLoop(); });
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            workAvailable.notify_all();
+            for (auto& worker : workers)
+                worker.join();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        static int HardwareThreads()
+        {
+            unsigned count = std::thread::hardware_concurrency();
+            return count == 0 ? 1 : (int)count;
+        }
+
+        int GetThreadCount() const { return (int)workers.size(); }
+
+        template <typename Task>
+        std::future<typename std::invoke_result<Task>::type> Submit(Task task)
+        {
+            using Result = typename std::invoke_result<Task>::type;
+
+            // packaged_task не копируется, а std::function требует копируемости
+            auto packaged = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+            std::future<Result> result = packaged->get_future();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                tasks.emplace_back([packaged]() { (*packaged)(); });
+            }
+            workAvailable.notify_one();
+            return result;
+        }
+
+        // chunk(index) для index = 0..chunkCount-1; возврат - после завершения всех кусков,
+        // первое исключение куска пробрасывается. Если открыт другой проход (вложенный вызов
+        // или параллельный вызов из другого потока), куски выполняются в вызывающем потоке:
+        // вызывающий никогда не ждёт невыданных кусков, поэтому вложенные проходы не блокируются
+        template <typename Chunk>
+        void RunChunks(int chunkCount, Chunk& chunk)
+        {
+            ChunkRun run = { [](void* context, int index) { (*static_cast<Chunk*>(context))(index); },
+                &chunk, chunkCount, 0, 0, 0, nullptr };
+
+            std::unique_lock<std::mutex> lock(mutex);
+            bool shared = openRun == nullptr && !workers.empty() && chunkCount > 1;
+            if (shared)
+            {
+                openRun = &run;
+                workAvailable.notify_all();
+            }
+
+            RunClaimedChunks(run, lock);
+            chunksFinished.wait(lock, [&run]() { return run.finishedChunks == run.chunkCount && run.helpers == 0; });
+            lock.unlock();
+
+            if (run.error)
+                std::rethrow_exception(run.error);
+        }
+
+    private:
+        // Выдача кусков под mutex, выполнение - без него. После выдачи последнего куска
+        // проход закрывается, и следующий RunChunks может открыть свой
+        void RunClaimedChunks(ChunkRun& run, std::unique_lock<std::mutex>& lock)
+        {
+            while (run.nextChunk < run.chunkCount)
+            {
+                int index = run.nextChunk++;
+                if (run.nextChunk == run.chunkCount && openRun == &run)
+                    openRun = nullptr;
+                lock.unlock();
+
+                std::exception_ptr error;
+                try
+                {
+                    run.invoke(run.context, index);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+
+                lock.lock();
+                if (error && !run.error)
+                    run.error = error;
+                run.finishedChunks++;
+            }
+        }
+
+        // Куски открытого прохода - раньше задач очереди; очередь выбирается до конца
+        // и после запроса остановки
+        void WorkerLoop()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;)
+            {
+                workAvailable.wait(lock, [this]() { return stopping || openRun != nullptr || !tasks.empty(); });
+
+                if (openRun != nullptr)
+                {
+                    ChunkRun& run = *openRun;
+                    run.helpers++;
+                    RunClaimedChunks(run, lock);
+                    run.helpers--;
+                    chunksFinished.notify_all();
+                    continue;
+                }
+
+                if (tasks.empty())
+                    return;
+
+                std::function<void()> task = std::move(tasks.front());
+                tasks.pop_front();
+                lock.unlock();
+                task();
+                lock.lock();
+            }
+        }
+    };
+}
+
+#endif
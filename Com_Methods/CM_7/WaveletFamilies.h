@@ -0,0 +1,374 @@
+#pragma once
+#ifndef WAVELET_FAMILIES_H
+#define WAVELET_FAMILIES_H
+
+namespace SignalProcessing
+{
+    // Таблицы НЧ-фильтров ортогональных вейвлетов с компактным носителем.
+    // ВЧ-фильтр строится как в WaveletProcessor: h[k] = HighpassSign * (-1)^(k+1) * l[1 - k]
+    namespace WaveletFamilies
+    {
+        // Хаар; знак ВЧ-фильтра как в WaveletProcessor: h = {1/sqrt(2), -1/sqrt(2)}
+        struct Haar
+        {
+            static constexpr int Length = 2;
+            static constexpr double HighpassSign = -1.0;
+            static constexpr double Lowpass[Length] = {
+                0.70710678118654752,
+                0.70710678118654752
+            };
+        };
+
+        // Добеши, 2 нулевых момента
+        struct Daubechies4
+        {
+            static constexpr int Length = 4;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.48296291314453416,
+                0.83651630373780794,
+                0.22414386804201339,
+                -0.12940952255126037
+            };
+        };
+
+        // Добеши, 3 нулевых момента (filterCoeffs из WaveletProcessor)
+        struct Daubechies6
+        {
+            static constexpr int Length = 6;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.3326705529500826,
+                0.8068915093110928,
+                0.4598775021184915,
+                -0.1350110200102546,
+                -0.08544127388202666,
+                0.03522629188570953
+            };
+        };
+
+        // Добеши, 4 нулевых момента
+        struct Daubechies8
+        {
+            static constexpr int Length = 8;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.23037781330889651,
+                0.71484657055291567,
+                0.63088076792985892,
+                -0.027983769416859854,
+                -0.18703481171909309,
+                0.030841381835560764,
+                0.032883011666885197,
+                -0.010597401785069032
+            };
+        };
+
+        // Добеши, 5 нулевых моментов
+        struct Daubechies10
+        {
+            static constexpr int Length = 10;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.16010239797419293,
+                0.60382926979718965,
+                0.72430852843777294,
+                0.13842814590132074,
+                -0.24229488706638203,
+                -0.032244869584638375,
+                0.077571493840045719,
+                -0.0062414902127982744,
+                -0.012580751999081999,
+                0.0033357252854737712
+            };
+        };
+
+        // Добеши, 6 нулевых моментов
+        struct Daubechies12
+        {
+            static constexpr int Length = 12;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.11154074335010947,
+                0.49462389039845306,
+                0.75113390802109536,
+                0.31525035170919763,
+                -0.22626469396543983,
+                -0.12976686756726194,
+                0.097501605587323043,
+                0.027522865530305727,
+                -0.03158203931748603,
+                0.00055384220116149613,
+                0.0047772575109455108,
+                -0.0010773010853084796
+            };
+        };
+
+        // Добеши, 7 нулевых моментов
+        struct Daubechies14
+        {
+            static constexpr int Length = 14;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.077852054085009184,
+                0.39653931948191729,
+                0.72913209084623509,
+                0.46978228740519312,
+                -0.14390600392856498,
+                -0.22403618499387498,
+                0.071309219266830259,
+                0.080612609151083078,
+                -0.038029936935014413,
+                -0.016574541630666881,
+                0.01255099855609984,
+                0.00042957797292136651,
+                -0.0018016407040474908,
+                0.00035371379997452024
+            };
+        };
+
+        // Добеши, 8 нулевых моментов
+        struct Daubechies16
+        {
+            static constexpr int Length = 16;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.054415842243104008,
+                0.31287159091429995,
+                0.67563073629728976,
+                0.58535468365420673,
+                -0.015829105256349306,
+                -0.28401554296154691,
+                0.00047248457391328279,
+                0.12874742662047847,
+                -0.017369301001807547,
+                -0.044088253930794755,
+                0.013981027917398282,
+                0.0087460940474057766,
+                -0.0048703529934515741,
+                -0.00039174037337694705,
+                0.00067544940645056933,
+                -0.00011747678412476953
+            };
+        };
+
+        // Добеши, 9 нулевых моментов
+        struct Daubechies18
+        {
+            static constexpr int Length = 18;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.038077947363878345,
+                0.24383467461259034,
+                0.60482312369011115,
+                0.65728807805130052,
+                0.13319738582500756,
+                -0.29327378327917492,
+                -0.096840783222976456,
+                0.14854074933810638,
+                0.03072568147933338,
+                -0.067632829061329974,
+                0.00025094711483145197,
+                0.022361662123679096,
+                -0.0047232047577513972,
+                -0.0042815036824634303,
+                0.0018476468830562265,
+                0.00023038576352319597,
+                -0.00025196318894271012,
+                3.9347320316271603e-05
+            };
+        };
+
+        // Добеши, 10 нулевых моментов
+        struct Daubechies20
+        {
+            static constexpr int Length = 20;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.026670057900555554,
+                0.1881768000776915,
+                0.52720118893172563,
+                0.68845903945360354,
+                0.28117234366057747,
+                -0.24984642432731538,
+                -0.19594627437737705,
+                0.12736934033579325,
+                0.093057364603572348,
+                -0.071394147166397082,
+                -0.029457536821875813,
+                0.033212674059341002,
+                0.0036065535669561697,
+                -0.010733175483330575,
+                0.0013953517470529011,
+                0.0019924052951850561,
+                -0.00068585669495971162,
+                -0.00011646685512928545,
+                9.3588670320069592e-05,
+                -1.3264202894521244e-05
+            };
+        };
+
+        // Симлет, 4 нулевых момента
+        struct Symlet4
+        {
+            static constexpr int Length = 8;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.032223100604051466,
+                -0.012603967262031304,
+                -0.099219543576633526,
+                0.29785779560530606,
+                0.8037387518051321,
+                0.49761866763277501,
+                -0.029635527646002493,
+                -0.075765714789502212
+            };
+        };
+
+        // Симлет, 5 нулевых моментов
+        struct Symlet5
+        {
+            static constexpr int Length = 10;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.019538882735249827,
+                -0.021101834024689042,
+                -0.17532808990805623,
+                0.016602105764510849,
+                0.63397896345679206,
+                0.72340769040404074,
+                0.19939753397685558,
+                -0.039134249302313844,
+                0.029519490925706261,
+                0.027333068344998768
+            };
+        };
+
+        // Симлет, 6 нулевых моментов
+        struct Symlet6
+        {
+            static constexpr int Length = 12;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.015404109327044824,
+                0.0034907120842221626,
+                -0.11799011114852002,
+                -0.048311742585698057,
+                0.49105594192797375,
+                0.78764114102865102,
+                0.33792942172816581,
+                -0.072637522786376585,
+                -0.021060292512370848,
+                0.044724901770781388,
+                0.0017677118642540077,
+                -0.0078007083250323803
+            };
+        };
+
+        // Симлет, 7 нулевых моментов
+        struct Symlet7
+        {
+            static constexpr int Length = 14;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.0022918339540537714,
+                -0.0032832978474668108,
+                -0.018126605131338461,
+                0.020464207577546033,
+                0.044742349468352378,
+                -0.1010109208684203,
+                -0.056804476889666972,
+                0.48361091568226772,
+                0.78192159329172817,
+                0.3602184609062602,
+                -0.064131289807385819,
+                -0.064908003547188481,
+                0.017213376300804502,
+                0.012015419283549189
+            };
+        };
+
+        // Симлет, 8 нулевых моментов
+        struct Symlet8
+        {
+            static constexpr int Length = 16;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.0018899503327676891,
+                -0.00030292051472413309,
+                -0.014952258337062199,
+                0.0038087520138944896,
+                0.04913717967373029,
+                -0.027219029917103486,
+                -0.051945838107881802,
+                0.36444189483617895,
+                0.777185751699628,
+                0.48135965125905339,
+                -0.061273359067811076,
+                -0.14329423835127267,
+                0.0076074873249766086,
+                0.031695087811525989,
+                -0.00054213233180001072,
+                -0.0033824159510050028
+            };
+        };
+
+        // Симлет, 9 нулевых моментов
+        struct Symlet9
+        {
+            static constexpr int Length = 18;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.001069490032908612,
+                -0.00047315449868004354,
+                -0.010264064027633121,
+                0.0088592674934002674,
+                0.062077789302885746,
+                -0.018233770779395506,
+                -0.19155083129728434,
+                0.035272488035271041,
+                0.61733844914093416,
+                0.71789708276441244,
+                0.23876091460730517,
+                -0.054568958430833349,
+                0.00058346274612498187,
+                0.030224878858275187,
+                -0.011528210207679187,
+                -0.013271967781817134,
+                0.00061978088898550707,
+                0.0014009155259146562
+            };
+        };
+
+        // Симлет, 10 нулевых моментов
+        struct Symlet10
+        {
+            static constexpr int Length = 20;
+            static constexpr double HighpassSign = 1.0;
+            static constexpr double Lowpass[Length] = {
+                0.00086257822622597244,
+                0.00071542054205433971,
+                -0.0070567640625873044,
+                0.00059568278374251906,
+                0.049686126646942878,
+                0.026240365058448987,
+                -0.12155210554854895,
+                -0.015019238839137859,
+                0.51370987334802631,
+                0.76695483656060959,
+                0.34021601302346216,
+                -0.087878711511975141,
+                -0.067089907808381796,
+                0.033842354663575221,
+                -0.00086875210968925809,
+                -0.02300546135349751,
+                -0.0011404297952173285,
+                0.0050716491985317988,
+                0.00034014926631480987,
+                -0.00041011591580439831
+            };
+        };
+    }
+}
+
+#endif
@@ -2,11 +2,22 @@
 #include "MathConstants.h"
 #include "SignalOperations.h"
 #include "SignalTransformer.h"
+#include "SignalViews.h"
+#include "ComplexKernels.h"
+#include "LiftingWavelet.h"
+#include "ParallelFor.h"
+#include "BlockedTranspose.h"
+#include "WorkspacePool.h"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
+#include <type_traits>
 
 namespace SignalProcessing
 {
+    // Фильтры с большим числом отводов применяются через БПФ
+    static const int DENSE_FILTER_TAPS = 32;
+
     // ��������������� ������� ��� ����������� ���������� ������� �� ������
     static int wrapIndex(int a, int n)
     {
@@ -14,12 +25,140 @@ namespace SignalProcessing
         return (r < 0) ? (r + n) : r;
     }
 
+    // Аддитивная энтропийная стоимость узла (Койфман - Викерхаузер)
+    template <typename Sample>
+    static double ComputeEntropyCost(const std::vector<Sample>& coeffs, double signalEnergy)
+    {
+        double cost = 0.0;
+        for (int i = 0; i < (int)coeffs.size(); i++)
+        {
+            double p = std::norm(coeffs[i]) / signalEnergy;
+            if (p > 0.0)
+                cost -= p * std::log(p);
+        }
+        return cost;
+    }
+
+    // Коэффициенты уровня лежат с шагом stride: 1 в пирамиде, 2^level в буфере лифтинга
+
+    // sigma = median(|d|) / 0.6745 - робастная оценка шума по самому мелкому уровню
+    template <typename Sample>
+    static double EstimateNoiseLevel(const Sample* coeffs, int count, int stride)
+    {
+        if (count == 0)
+            return 0.0;
+
+        WorkspacePool& workspace = WorkspacePool::ForThread();
+        WorkspacePool::Scope scope(workspace);
+        std::vector<double>& magnitudes = workspace.Acquire<double>(count);
+        for (int k = 0; k < count; k++)
+            magnitudes[k] = std::abs(coeffs[k * stride]);
+
+        std::nth_element(magnitudes.begin(), magnitudes.begin() + count / 2, magnitudes.end());
+        return magnitudes[count / 2] / 0.6745;
+    }
+
+    // SureShrink: порог минимизирует SURE(t) = n - 2 #{|x| <= t} + sum min(x^2, t^2) для x = d / sigma;
+    // на разреженных уровнях оценка риска неустойчива и берётся универсальный порог
+    template <typename Sample>
+    static double ComputeSureThreshold(const Sample* coeffs, int count, int stride, double sigma)
+    {
+        double universal = std::sqrt(2.0 * std::log((double)count));
+        WorkspacePool& workspace = WorkspacePool::ForThread();
+        WorkspacePool::Scope scope(workspace);
+        std::vector<double>& squares = workspace.Acquire<double>(count);
+        double energy = 0.0;
+        for (int k = 0; k < count; k++)
+        {
+            double x = std::abs(coeffs[k * stride]) / sigma;
+            squares[k] = x * x;
+            energy += squares[k];
+        }
+
+        double sparsity = (energy - count) / count;
+        double criterion = std::pow(std::log2((double)count), 1.5) / std::sqrt((double)count);
+        if (sparsity <= criterion)
+            return sigma * universal;
+
+        std::sort(squares.begin(), squares.end());
+        double bestRisk = (double)count, bestSquare = 0.0, partialSum = 0.0;
+        for (int k = 0; k < count; k++)
+        {
+            partialSum += squares[k];
+            double risk = count - 2.0 * (k + 1) + partialSum + (count - k - 1) * squares[k];
+            if (risk < bestRisk)
+            {
+                bestRisk = risk;
+                bestSquare = squares[k];
+            }
+        }
+        return sigma * std::min(std::sqrt(bestSquare), universal);
+    }
+
+    // BayesShrink: lambda = sigma^2 / sigma_x, sigma_x^2 = max(E|d|^2 - sigma^2, 0);
+    // при sigma_x = 0 уровень считается чистым шумом и обнуляется
+    template <typename Sample>
+    static double ComputeBayesThreshold(const Sample* coeffs, int count, int stride, double sigma)
+    {
+        double energy = 0.0, maxMagnitude = 0.0;
+        for (int k = 0; k < count; k++)
+        {
+            energy += std::norm(coeffs[k * stride]);
+            maxMagnitude = std::max(maxMagnitude, std::abs(coeffs[k * stride]));
+        }
+
+        double signalVariance = energy / count - sigma * sigma;
+        if (signalVariance <= 0.0)
+            return maxMagnitude;
+        return sigma * sigma / std::sqrt(signalVariance);
+    }
+
+    template <typename Sample>
+    static void ThresholdLevel(Sample* coeffs, int count, int stride, double sigma, int signalLength,
+        WaveletProcessorTypes::ThresholdRule rule, WaveletProcessorTypes::ThresholdSelection selection)
+    {
+        if (count == 0 || sigma <= 0.0)
+            return;
+
+        double threshold;
+        switch (selection)
+        {
+        case WaveletProcessorTypes::ThresholdSelection::SURE:
+            threshold = ComputeSureThreshold(coeffs, count, stride, sigma);
+            break;
+        case WaveletProcessorTypes::ThresholdSelection::BayesShrink:
+            threshold = ComputeBayesThreshold(coeffs, count, stride, sigma);
+            break;
+        default:
+            threshold = sigma * std::sqrt(2.0 * std::log((double)signalLength));
+            break;
+        }
+
+        // Для комплексных коэффициентов мягкий порог уменьшает модуль, сохраняя фазу
+        for (int k = 0; k < count; k++)
+        {
+            Sample& value = coeffs[k * stride];
+            double magnitude = std::abs(value);
+            if (magnitude <= threshold)
+                value = Sample(0.0);
+            else if (rule == WaveletProcessorTypes::ThresholdRule::Soft)
+                value *= (magnitude - threshold) / magnitude;
+        }
+    }
+
     // �����������: �������� �������� ��� ���������� ���� ��������
-    WaveletProcessor::WaveletProcessor(int dataSize, WaveletType type)
+    template <typename Sample>
+    BasicWaveletProcessor<Sample>::BasicWaveletProcessor(int dataSize, WaveletType type, TransformMode transformMode)
+        : waveletType(type), mode(transformMode)
     {
+        if (mode == TransformMode::Lifting && type == WaveletType::Shannon)
+            throw std::runtime_error("Лифтинг-схема доступна только для вейвлетов с компактным носителем");
+        if (!SampleTraits<Sample>::IsComplex && type == WaveletType::Shannon)
+            throw std::runtime_error("Фильтр Шеннона комплексный: используйте WaveletProcessor");
+
         int N = dataSize;
-        lowpassFilter.assign(N, std::complex<double>(0.0, 0.0));
-        highpassFilter.assign(N, std::complex<double>(0.0, 0.0));
+        lowpassFilter.assign(N, Sample(0.0));
+        highpassFilter.assign(N, Sample(0.0));
 
         switch (type)
         {
@@ -29,16 +168,16 @@ namespace SignalProcessing
                 throw std::runtime_error("��� ������ ������� N ������ ���� ������ 4");
 
             double sqrt2 = 1.0 / std::sqrt(2.0);
-            lowpassFilter[0] = std::complex<double>(sqrt2, 0.0);
-            highpassFilter[0] = std::complex<double>(sqrt2, 0.0);
+            lowpassFilter[0] = Sample(sqrt2);
+            highpassFilter[0] = Sample(sqrt2);
 
             for (int i = 1; i < N; i++)
             {
                 double denominator = std::sin(Constants::PI * i / N);
                 if (std::abs(denominator) < 1e-10)
                 {
-                    lowpassFilter[i] = std::complex<double>(0.0, 0.0);
-                    highpassFilter[i] = std::complex<double>(0.0, 0.0);
+                    lowpassFilter[i] = Sample(0.0);
+                    highpassFilter[i] = Sample(0.0);
                     continue;
                 }
 
@@ -47,20 +186,19 @@ namespace SignalProcessing
                 double imagPart = -std::sqrt(2.0) / N * std::sin(Constants::PI * i / N) *
                     std::sin(Constants::PI * i / 2.0) / denominator;
 
-                std::complex<double> value(realPart, imagPart);
-                lowpassFilter[i] = value;
-                highpassFilter[i] = std::complex<double>(((i % 2 == 0) ? 1 : -1) * value.real(),
-                    ((i % 2 == 0) ? 1 : -1) * value.imag());
+                double sign = (i % 2 == 0) ? 1 : -1;
+                lowpassFilter[i] = SampleTraits<Sample>::Compose(realPart, imagPart);
+                highpassFilter[i] = SampleTraits<Sample>::Compose(sign * realPart, sign * imagPart);
             }
             break;
         }
         case WaveletType::Haar:
         {
             double scale = 1.0 / std::sqrt(2.0);
-            lowpassFilter[0] = std::complex<double>(scale, 0.0);
-            lowpassFilter[1] = std::complex<double>(scale, 0.0);
-            highpassFilter[0] = std::complex<double>(scale, 0.0);
-            highpassFilter[1] = std::complex<double>(-scale, 0.0);
+            lowpassFilter[0] = Sample(scale);
+            lowpassFilter[1] = Sample(scale);
+            highpassFilter[0] = Sample(scale);
+            highpassFilter[1] = Sample(-scale);
             break;
         }
         case WaveletType::Daubechies6:
@@ -76,14 +214,14 @@ namespace SignalProcessing
 
             for (int i = 0; i < 6; i++)
             {
-                lowpassFilter[i] = std::complex<double>(filterCoeffs[i], 0.0);
+                lowpassFilter[i] = Sample(filterCoeffs[i]);
             }
 
             for (int k = 0; k < N; k++)
             {
                 int idx = wrapIndex(1 - k, N);
                 double sign = (k % 2 == 0) ? -1.0 : 1.0;
-                highpassFilter[k] = std::complex<double>(sign * lowpassFilter[idx].real(), 0.0);
+                highpassFilter[k] = Sample(sign * SampleTraits<Sample>::Real(lowpassFilter[idx]));
             }
             break;
         }
@@ -93,139 +231,975 @@ namespace SignalProcessing
     }
 
     // ���������� ������� �������� ��� ��������� ���������� ������
-    void WaveletProcessor::BuildFilterSystem(int stages)
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::BuildFilterSystem(int stages)
     {
-        SignalOperations operations;
+        int builtStages = (int)reconstructionFilters.size();
+        if (builtStages >= stages)
+            return;
+
+        SignalTransformer transformer;
         int N = (int)lowpassFilter.size();
 
-        std::vector<std::vector<std::complex<double>>> lowFilters(stages);
-        std::vector<std::vector<std::complex<double>>> highFilters(stages);
+        decompositionFilters.resize(stages);
+        reconstructionFilters.resize(stages);
+        reconstructionSpectra.resize(stages);
 
-        lowFilters[0] = lowpassFilter;
-        highFilters[0] = highpassFilter;
+        // Спектры считаются в комплексной арифметике, фильтры хранятся в типе Sample
+        std::vector<std::complex<double>> samples;
+        if (builtStages == 0)
+        {
+            decompositionFilters[0] = highpassFilter;
+            reconstructionFilters[0] = lowpassFilter;
+            LoadSamples(lowpassFilter, samples);
+            transformer.FastFourierTransform(samples, reconstructionSpectra[0]);
+            builtStages = 1;
+        }
+
+        // Достраиваем только недостающие уровни, спектр предыдущего уровня берём из кэша
+        std::vector<Sample> lowFilter, highFilter;
+        std::vector<std::complex<double>> lowSpectrum, highSpectrum;
 
-        for (int i = 1; i < stages; i++)
+        for (int i = builtStages; i < stages; i++)
         {
-            int elementCount = N / (int)std::pow(2.0, i);
-            lowFilters[i].assign(elementCount, std::complex<double>(0.0, 0.0));
-            highFilters[i].assign(elementCount, std::complex<double>(0.0, 0.0));
+            int elementCount = N >> i;
+            int maxIdx = 1 << i;
+            lowFilter.assign(elementCount, Sample(0.0));
+            highFilter.assign(elementCount, Sample(0.0));
 
             for (int n = 0; n < elementCount; n++)
             {
-                int maxIdx = (int)std::pow(2.0, i);
                 for (int k = 0; k < maxIdx; k++)
                 {
-                    lowFilters[i][n] += lowFilters[0][n + k * N / maxIdx];
-                    highFilters[i][n] += highFilters[0][n + k * N / maxIdx];
+                    lowFilter[n] += lowpassFilter[n + k * elementCount];
+                    highFilter[n] += highpassFilter[n + k * elementCount];
                 }
             }
+
+            // Повышение частоты - представление, сразу записываемое в комплексный буфер БПФ
+            Views::Materialize(Views::Upsample(Views::View(lowFilter), i), samples);
+            transformer.FastFourierTransform(samples, lowSpectrum);
+            Views::Materialize(Views::Upsample(Views::View(highFilter), i), samples);
+            transformer.FastFourierTransform(samples, highSpectrum);
+
+            Kernels::PointwiseMultiply(lowSpectrum.data(), reconstructionSpectra[i - 1].data(), lowSpectrum.data(), N);
+            Kernels::PointwiseMultiply(highSpectrum.data(), reconstructionSpectra[i - 1].data(), highSpectrum.data(), N);
+
+            transformer.InverseFastFourierTransform(highSpectrum, samples);
+            StoreSamples(samples, decompositionFilters[i]);
+            transformer.InverseFastFourierTransform(lowSpectrum, samples);
+            StoreSamples(samples, reconstructionFilters[i]);
+            reconstructionSpectra[i] = lowSpectrum;
         }
+    }
 
-        SignalTransformer transformer;
-        std::vector<std::complex<double>> upsampledLow, upsampledHigh;
+    // ���� �������: ���������� ������� �� ������������
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::DecomposeByProjection(int stage,
+        const std::vector<Sample>& inputSignal,
+        std::vector<Sample>& waveletCoeffs,
+        std::vector<Sample>& scalingCoeffs)
+    {
+        SignalOperations operations;
+        BuildFilterSystem(stage);
 
-        decompositionFilters.resize(stages);
-        reconstructionFilters.resize(stages);
+        const std::vector<Sample>& waveletFilter = decompositionFilters[stage - 1];
+        const std::vector<Sample>& scalingFilter = reconstructionFilters[stage - 1];
 
-        decompositionFilters[0] = highFilters[0];
-        reconstructionFilters[0] = lowFilters[0];
+        int basisElements = (int)lowpassFilter.size() >> stage;
+        waveletCoeffs.assign(basisElements, Sample(0.0));
+        scalingCoeffs.assign(basisElements, Sample(0.0));
 
-        for (int i = 1; i < stages; i++)
+        // Базисные функции - сдвиги фильтров на 2^stage * i, сдвиг выполняется индексами
+        for (int basisIdx = 0; basisIdx < basisElements; basisIdx++)
         {
-            operations.ApplyUpsampling(i, lowFilters[i], upsampledLow);
-            operations.ApplyUpsampling(i, highFilters[i], upsampledHigh);
-
-            transformer.ComputeConvolution(reconstructionFilters[i - 1], upsampledHigh, decompositionFilters[i]);
-            transformer.ComputeConvolution(reconstructionFilters[i - 1], upsampledLow, reconstructionFilters[i]);
+            int shiftAmount = basisIdx << stage;
+            waveletCoeffs[basisIdx] = operations.ComputeShiftedDotProduct(shiftAmount, inputSignal, waveletFilter);
+            scalingCoeffs[basisIdx] = operations.ComputeShiftedDotProduct(shiftAmount, inputSignal, scalingFilter);
         }
     }
 
-    // ��������� �������� ������� ��� ��������� �����
-    void WaveletProcessor::GenerateBasisFunctions(int stage,
-        std::vector<std::vector<std::complex<double>>>& waveletBasis,
-        std::vector<std::vector<std::complex<double>>>& scalingBasis)
+    // ���� �������: �������������� ������� �� �������������
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::ReconstructByProjection(int stage,
+        const std::vector<Sample>& waveletCoeffs,
+        const std::vector<Sample>& scalingCoeffs,
+        std::vector<Sample>& lowpassPart,
+        std::vector<Sample>& highpassPart,
+        std::vector<Sample>& reconstructedSignal)
     {
         SignalOperations operations;
+        BuildFilterSystem(stage);
+
+        const std::vector<Sample>& waveletFilter = decompositionFilters[stage - 1];
+        const std::vector<Sample>& scalingFilter = reconstructionFilters[stage - 1];
 
+        int basisElements = (int)waveletCoeffs.size();
         int dataSize = (int)lowpassFilter.size();
-        int basisElements = dataSize / (int)std::pow(2.0, stage);
 
-        if ((int)reconstructionFilters.size() < stage)
+        lowpassPart.assign(dataSize, Sample(0.0));
+        highpassPart.assign(dataSize, Sample(0.0));
+        reconstructedSignal.assign(dataSize, Sample(0.0));
+
+        for (int basisIdx = 0; basisIdx < basisElements; basisIdx++)
         {
-            BuildFilterSystem(stage + 1);
+            int shiftAmount = basisIdx << stage;
+            operations.AccumulateShifted(shiftAmount, scalingCoeffs[basisIdx], scalingFilter, lowpassPart);
+            operations.AccumulateShifted(shiftAmount, waveletCoeffs[basisIdx], waveletFilter, highpassPart);
         }
 
-        waveletBasis.resize(basisElements);
-        scalingBasis.resize(basisElements);
+        for (int dataIdx = 0; dataIdx < dataSize; dataIdx++)
+            reconstructedSignal[dataIdx] = lowpassPart[dataIdx] + highpassPart[dataIdx];
+    }
 
-        for (int i = 0; i < basisElements; i++)
+    // Периодизация фильтра длины N на length отсчётов; ненулевые отводы хранятся отдельно
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::PeriodizeFilter(const std::vector<Sample>& filter, int length,
+        BankFilter& result)
+    {
+        std::vector<Sample> periodized(length, Sample(0.0));
+        for (int n = 0; n < (int)filter.size(); n++)
+            periodized[n % length] += filter[n];
+
+        result.tapPositions.clear();
+        result.tapValues.clear();
+        for (int n = 0; n < length; n++)
         {
-            int shiftAmount = (int)std::pow(2.0, stage) * i;
+            if (periodized[n] != Sample(0.0))
+            {
+                result.tapPositions.push_back(n);
+                result.tapValues.push_back(periodized[n]);
+            }
+        }
 
-            std::vector<std::complex<double>> shiftedWavelet;
-            operations.PerformCircularShift(shiftAmount, decompositionFilters[stage - 1], shiftedWavelet);
-            waveletBasis[i] = shiftedWavelet;
+        // Плотные фильтры (Шеннон) применяются через БПФ
+        result.spectrum.clear();
+        if ((int)result.tapPositions.size() > DENSE_FILTER_TAPS)
+        {
+            SignalTransformer transformer;
+            std::vector<std::complex<double>> samples;
+            LoadSamples(periodized, samples);
+            transformer.FastFourierTransform(samples, result.spectrum);
+        }
+    }
+
+    // Банк фильтров для уровней 1..stages
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::BuildFilterBank(int stages)
+    {
+        int N = (int)lowpassFilter.size();
+        int builtStages = (int)lowpassBank.size();
+        if (builtStages >= stages)
+            return;
 
-            std::vector<std::complex<double>> shiftedScaling;
-            operations.PerformCircularShift(shiftAmount, reconstructionFilters[stage - 1], shiftedScaling);
-            scalingBasis[i] = shiftedScaling;
+        lowpassBank.resize(stages);
+        highpassBank.resize(stages);
+        for (int i = builtStages; i < stages; i++)
+        {
+            PeriodizeFilter(lowpassFilter, N >> i, lowpassBank[i]);
+            PeriodizeFilter(highpassFilter, N >> i, highpassBank[i]);
         }
     }
 
-    // ���� �������: ���������� ������� �� ������������
-    void WaveletProcessor::PerformDecomposition(int stage,
-        const std::vector<std::complex<double>>& inputSignal,
-        std::vector<std::complex<double>>& waveletCoeffs,
-        std::vector<std::complex<double>>& scalingCoeffs)
+    // Анализ: output[k] = sum_j conj(f[j]) * input[(2k + j) mod M]
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::AnalysisStep(const BankFilter& filter,
+        const std::vector<Sample>& input,
+        std::vector<Sample>& output)
+    {
+        int size = (int)input.size();
+        int halfSize = size / 2;
+
+        if (!filter.spectrum.empty())
+        {
+            SignalTransformer transformer;
+            WorkspacePool& workspace = WorkspacePool::ForThread();
+            WorkspacePool::Scope scope(workspace);
+            std::vector<std::complex<double>>& samples = workspace.Acquire<std::complex<double>>(size);
+            std::vector<std::complex<double>>& inputSpectrum = workspace.Acquire<std::complex<double>>(size);
+            std::vector<std::complex<double>>& correlation = workspace.Acquire<std::complex<double>>(size);
+            LoadSamples(input, samples);
+            transformer.FastFourierTransform(samples, inputSpectrum);
+            Kernels::PointwiseMultiplyConjugate(inputSpectrum.data(), filter.spectrum.data(), inputSpectrum.data(), size);
+            transformer.InverseFastFourierTransform(inputSpectrum, correlation);
+            Views::Materialize(Views::Downsample(Views::View(correlation), 1), output);
+            return;
+        }
+
+        int taps = (int)filter.tapPositions.size();
+        output.assign(halfSize, Sample(0.0));
+        for (int k = 0; k < halfSize; k++)
+        {
+            Sample accum(0.0);
+            for (int t = 0; t < taps; t++)
+            {
+                int idx = 2 * k + filter.tapPositions[t];
+                if (idx >= size) idx %= size;
+                accum += input[idx] * SampleTraits<Sample>::Conjugate(filter.tapValues[t]);
+            }
+            output[k] = accum;
+        }
+    }
+
+    // Синтез: output[m] = sum_k input[k] * f[(m - 2k) mod M]
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::SynthesisStep(const BankFilter& filter,
+        const std::vector<Sample>& input,
+        std::vector<Sample>& output)
+    {
+        int halfSize = (int)input.size();
+        int size = 2 * halfSize;
+
+        if (!filter.spectrum.empty())
+        {
+            SignalTransformer transformer;
+            WorkspacePool& workspace = WorkspacePool::ForThread();
+            WorkspacePool::Scope scope(workspace);
+            std::vector<std::complex<double>>& samples = workspace.Acquire<std::complex<double>>(size);
+            std::vector<std::complex<double>>& upsampledSpectrum = workspace.Acquire<std::complex<double>>(size);
+            Views::Materialize(Views::Upsample(Views::View(input), 1), samples);
+            transformer.FastFourierTransform(samples, upsampledSpectrum);
+            Kernels::PointwiseMultiply(upsampledSpectrum.data(), filter.spectrum.data(), upsampledSpectrum.data(), size);
+            transformer.InverseFastFourierTransform(upsampledSpectrum, samples);
+            StoreSamples(samples, output);
+            return;
+        }
+
+        int taps = (int)filter.tapPositions.size();
+        output.assign(size, Sample(0.0));
+        for (int k = 0; k < halfSize; k++)
+        {
+            for (int t = 0; t < taps; t++)
+            {
+                int idx = 2 * k + filter.tapPositions[t];
+                if (idx >= size) idx %= size;
+                output[idx] += input[k] * filter.tapValues[t];
+            }
+        }
+    }
+
+    // Восстановление вклада коэффициентов уровня stage на исходную сетку длины N
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::SynthesizeToSignal(int stage, const BankFilter& firstFilter,
+        const std::vector<Sample>& coeffs,
+        std::vector<Sample>& result)
+    {
+        WorkspacePool& workspace = WorkspacePool::ForThread();
+        WorkspacePool::Scope scope(workspace);
+        std::vector<Sample>& current = workspace.Acquire<Sample>(0);
+        SynthesisStep(firstFilter, coeffs, current);
+        for (int i = stage - 2; i >= 0; i--)
+        {
+            SynthesisStep(lowpassBank[i], current, result);
+            current.swap(result);
+        }
+        result.swap(current);
+    }
+
+    // Быстрое разложение: каскад свёрток с прореживанием
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::DecomposeByFilterBank(int stage,
+        const std::vector<Sample>& inputSignal,
+        std::vector<Sample>& waveletCoeffs,
+        std::vector<Sample>& scalingCoeffs)
+    {
+        BuildFilterBank(stage);
+
+        WorkspacePool& workspace = WorkspacePool::ForThread();
+        WorkspacePool::Scope scope(workspace);
+        std::vector<Sample>& approximation = workspace.Acquire<Sample>(0);
+        approximation.assign(inputSignal.begin(), inputSignal.end());
+        for (int i = 0; i < stage - 1; i++)
+        {
+            AnalysisStep(lowpassBank[i], approximation, scalingCoeffs);
+            approximation.swap(scalingCoeffs);
+        }
+
+        AnalysisStep(highpassBank[stage - 1], approximation, waveletCoeffs);
+        AnalysisStep(lowpassBank[stage - 1], approximation, scalingCoeffs);
+    }
+
+    // Быстрое восстановление: каскад повышения частоты с фильтрацией
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::ReconstructByFilterBank(int stage,
+        const std::vector<Sample>& waveletCoeffs,
+        const std::vector<Sample>& scalingCoeffs,
+        std::vector<Sample>& lowpassPart,
+        std::vector<Sample>& highpassPart,
+        std::vector<Sample>& reconstructedSignal)
+    {
+        BuildFilterBank(stage);
+
+        SynthesizeToSignal(stage, lowpassBank[stage - 1], scalingCoeffs, lowpassPart);
+        SynthesizeToSignal(stage, highpassBank[stage - 1], waveletCoeffs, highpassPart);
+
+        int dataSize = (int)lowpassPart.size();
+        reconstructedSignal.assign(dataSize, Sample(0.0));
+        for (int i = 0; i < dataSize; i++)
+            reconstructedSignal[i] = lowpassPart[i] + highpassPart[i];
+    }
+
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::PerformDecomposition(int stage,
+        const std::vector<Sample>& inputSignal,
+        std::vector<Sample>& waveletCoeffs,
+        std::vector<Sample>& scalingCoeffs)
+    {
+        switch (mode)
+        {
+        case TransformMode::FilterBank:
+            DecomposeByFilterBank(stage, inputSignal, waveletCoeffs, scalingCoeffs);
+            break;
+        case TransformMode::Lifting:
+        {
+            // Рабочая пирамида только растёт: буферы более глубоких уровней сохраняются между вызовами
+            if ((int)workspacePyramid.waveletCoeffs.size() < stage)
+            {
+                workspacePyramid.waveletCoeffs.resize(stage);
+                workspacePyramid.scalingCoeffs.resize(stage);
+            }
+            DecomposeByLifting(stage, inputSignal, workspacePyramid);
+            waveletCoeffs.assign(workspacePyramid.waveletCoeffs[stage - 1].begin(), workspacePyramid.waveletCoeffs[stage - 1].end());
+            scalingCoeffs.assign(workspacePyramid.scalingCoeffs[stage - 1].begin(), workspacePyramid.scalingCoeffs[stage - 1].end());
+            break;
+        }
+        default:
+            DecomposeByProjection(stage, inputSignal, waveletCoeffs, scalingCoeffs);
+            break;
+        }
+    }
+
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::PerformReconstruction(int stage,
+        const std::vector<Sample>& waveletCoeffs,
+        const std::vector<Sample>& scalingCoeffs,
+        std::vector<Sample>& lowpassPart,
+        std::vector<Sample>& highpassPart,
+        std::vector<Sample>& reconstructedSignal)
+    {
+        switch (mode)
+        {
+        case TransformMode::FilterBank:
+            ReconstructByFilterBank(stage, waveletCoeffs, scalingCoeffs, lowpassPart, highpassPart, reconstructedSignal);
+            break;
+        case TransformMode::Lifting:
+        {
+            SynthesizeByLifting(stage, true, scalingCoeffs, lowpassPart);
+            SynthesizeByLifting(stage, false, waveletCoeffs, highpassPart);
+
+            int dataSize = (int)lowpassPart.size();
+            reconstructedSignal.assign(dataSize, Sample(0.0));
+            for (int i = 0; i < dataSize; i++)
+                reconstructedSignal[i] = lowpassPart[i] + highpassPart[i];
+            break;
+        }
+        default:
+            ReconstructByProjection(stage, waveletCoeffs, scalingCoeffs, lowpassPart, highpassPart, reconstructedSignal);
+            break;
+        }
+    }
+
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::PerformMultilevelDecomposition(int stages,
+        const std::vector<Sample>& inputSignal,
+        DecompositionPyramid& pyramid)
+    {
+        pyramid.waveletCoeffs.resize(stages);
+        pyramid.scalingCoeffs.resize(stages);
+
+        if (mode == TransformMode::BasisProjection)
+        {
+            for (int i = 0; i < stages; i++)
+                DecomposeByProjection(i + 1, inputSignal, pyramid.waveletCoeffs[i], pyramid.scalingCoeffs[i]);
+            return;
+        }
+
+        if (mode == TransformMode::Lifting)
+        {
+            DecomposeByLifting(stages, inputSignal, pyramid);
+            return;
+        }
+
+        BuildFilterBank(stages);
+
+        for (int i = 0; i < stages; i++)
+        {
+            const std::vector<Sample>& approximation = (i == 0) ? inputSignal : pyramid.scalingCoeffs[i - 1];
+            AnalysisStep(highpassBank[i], approximation, pyramid.waveletCoeffs[i]);
+            AnalysisStep(lowpassBank[i], approximation, pyramid.scalingCoeffs[i]);
+        }
+    }
+
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::PerformPacketDecomposition(int stages,
+        const std::vector<Sample>& inputSignal,
+        WaveletPacketTree& tree,
+        bool selectBestBasis)
+    {
+        BuildFilterBank(stages);
+
+        tree.nodes.resize(stages + 1);
+        tree.nodes[0].assign(1, inputSignal);
+
+        for (int level = 0; level < stages; level++)
+        {
+            int nodeCount = 1 << level;
+            tree.nodes[level + 1].resize(2 * nodeCount);
+            for (int index = 0; index < nodeCount; index++)
+            {
+                AnalysisStep(lowpassBank[level], tree.nodes[level][index], tree.nodes[level + 1][2 * index]);
+                AnalysisStep(highpassBank[level], tree.nodes[level][index], tree.nodes[level + 1][2 * index + 1]);
+            }
+        }
+
+        tree.bestBasis.clear();
+        if (!selectBestBasis)
+            return;
+
+        double signalEnergy = 0.0;
+        for (int i = 0; i < (int)inputSignal.size(); i++)
+            signalEnergy += std::norm(inputSignal[i]);
+
+        SelectBestBasis(tree, signalEnergy);
+    }
+
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::PerformMultiresolutionAnalysis(int stages,
+        const std::vector<Sample>& inputSignal,
+        DecompositionPyramid& pyramid,
+        MultiresolutionComponents& components)
+    {
+        PerformMultilevelDecomposition(stages, inputSignal, pyramid);
+
+        int N = (int)inputSignal.size();
+        components.approximations.resize(stages);
+        components.details.resize(stages);
+
+        for (int level = 1; level <= stages; level++)
+        {
+            const std::vector<Sample>& previous = (level == 1) ? inputSignal : components.approximations[level - 2];
+            std::vector<Sample>& detail = components.details[level - 1];
+            std::vector<Sample>& approximation = components.approximations[level - 1];
+
+            SynthesizeDetail(level, pyramid.waveletCoeffs[level - 1], detail);
+
+            approximation.resize(N);
+            for (int i = 0; i < N; i++)
+                approximation[i] = previous[i] - detail[i];
+        }
+    }
+
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::SynthesizeDetail(int stage,
+        const std::vector<Sample>& waveletCoeffs,
+        std::vector<Sample>& detail)
+    {
+        switch (mode)
+        {
+        case TransformMode::FilterBank:
+            BuildFilterBank(stage);
+            SynthesizeToSignal(stage, highpassBank[stage - 1], waveletCoeffs, detail);
+            break;
+        case TransformMode::Lifting:
+            SynthesizeByLifting(stage, false, waveletCoeffs, detail);
+            break;
+        default:
+        {
+            SignalOperations operations;
+            BuildFilterSystem(stage);
+            detail.assign(lowpassFilter.size(), Sample(0.0));
+            for (int basisIdx = 0; basisIdx < (int)waveletCoeffs.size(); basisIdx++)
+                operations.AccumulateShifted(basisIdx << stage, waveletCoeffs[basisIdx], decompositionFilters[stage - 1], detail);
+            break;
+        }
+        }
+    }
+
+    // a_{s-1} = synth(lowpass, a_s) + synth(highpass, d_s) от самого грубого уровня к сигналу
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::ReconstructFromPyramid(int stages,
+        const DecompositionPyramid& pyramid,
+        std::vector<Sample>& output)
     {
+        BuildFilterBank(stages);
+
+        WorkspacePool& workspace = WorkspacePool::ForThread();
+        WorkspacePool::Scope scope(workspace);
+        std::vector<Sample>& approximation = workspace.Acquire<Sample>(0);
+        std::vector<Sample>& detailPart = workspace.Acquire<Sample>(0);
+        approximation.assign(pyramid.scalingCoeffs[stages - 1].begin(), pyramid.scalingCoeffs[stages - 1].end());
+        for (int level = stages; level >= 1; level--)
+        {
+            SynthesisStep(lowpassBank[level - 1], approximation, output);
+            SynthesisStep(highpassBank[level - 1], pyramid.waveletCoeffs[level - 1], detailPart);
+            for (int i = 0; i < (int)output.size(); i++)
+                output[i] += detailPart[i];
+            approximation.swap(output);
+        }
+        output.swap(approximation);
+    }
+
+    // Фильтр банка уровня s (период N / 2^(s - 1)), разреженный в 2^(s - 1) раз, - это
+    // исходный фильтр с дырами, периодизированный на N: отвод p переходит в p * 2^(s - 1).
+    // Плотный фильтр: спектр длины N повторяет спектр банка 2^(s - 1) раз
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::AtrousAnalysisStep(const BankFilter& filter, int dilation,
+        const std::vector<Sample>& input,
+        std::vector<Sample>& output)
+    {
+        int size = (int)input.size();
+
+        if (!filter.spectrum.empty())
+        {
+            SignalTransformer transformer;
+            WorkspacePool& workspace = WorkspacePool::ForThread();
+            WorkspacePool::Scope scope(workspace);
+            std::vector<std::complex<double>>& samples = workspace.Acquire<std::complex<double>>(size);
+            std::vector<std::complex<double>>& spectrum = workspace.Acquire<std::complex<double>>(size);
+            LoadSamples(input, samples);
+            transformer.FastFourierTransform(samples, spectrum);
+            int period = (int)filter.spectrum.size();
+            for (int offset = 0; offset < size; offset += period)
+                Kernels::PointwiseMultiplyConjugate(spectrum.data() + offset, filter.spectrum.data(),
+                    spectrum.data() + offset, period);
+            transformer.InverseFastFourierTransform(spectrum, samples);
+            StoreSamples(samples, output);
+            return;
+        }
+
+        // output[n] = sum_t conj(f_t) * input[(n + p_t * dilation) mod N]
         SignalOperations operations;
+        output.assign(size, Sample(0.0));
+        for (int t = 0; t < (int)filter.tapPositions.size(); t++)
+            operations.AccumulateShifted(-((filter.tapPositions[t] * dilation) % size),
+                SampleTraits<Sample>::Conjugate(filter.tapValues[t]), input, output);
+    }
 
-        std::vector<std::vector<std::complex<double>>> waveletBasis, scalingBasis;
-        GenerateBasisFunctions(stage, waveletBasis, scalingBasis);
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::AtrousSynthesisStep(const BankFilter& filter, int dilation,
+        const std::vector<Sample>& input,
+        std::vector<Sample>& output)
+    {
+        int size = (int)input.size();
 
-        int basisElements = (int)waveletBasis.size();
-        waveletCoeffs.assign(basisElements, std::complex<double>(0.0, 0.0));
-        scalingCoeffs.assign(basisElements, std::complex<double>(0.0, 0.0));
+        if (!filter.spectrum.empty())
+        {
+            SignalTransformer transformer;
+            WorkspacePool& workspace = WorkspacePool::ForThread();
+            WorkspacePool::Scope scope(workspace);
+            std::vector<std::complex<double>>& samples = workspace.Acquire<std::complex<double>>(size);
+            std::vector<std::complex<double>>& spectrum = workspace.Acquire<std::complex<double>>(size);
+            LoadSamples(input, samples);
+            transformer.FastFourierTransform(samples, spectrum);
+            int period = (int)filter.spectrum.size();
+            for (int offset = 0; offset < size; offset += period)
+                Kernels::PointwiseMultiply(spectrum.data() + offset, filter.spectrum.data(),
+                    spectrum.data() + offset, period);
+            transformer.InverseFastFourierTransform(spectrum, samples);
 
-        for (int basisIdx = 0; basisIdx < basisElements; basisIdx++)
+            std::vector<Sample>& contribution = workspace.Acquire<Sample>(size);
+            StoreSamples(samples, contribution);
+            for (int i = 0; i < size; i++)
+                output[i] += contribution[i] * 0.5;
+            return;
+        }
+
+        // output[m] += f_t / 2 * input[(m - p_t * dilation) mod N]
+        SignalOperations operations;
+        for (int t = 0; t < (int)filter.tapPositions.size(); t++)
+            operations.AccumulateShifted((filter.tapPositions[t] * dilation) % size,
+                filter.tapValues[t] * 0.5, input, output);
+    }
+
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::PerformStationaryDecomposition(int stages,
+        const std::vector<Sample>& inputSignal,
+        DecompositionPyramid& pyramid)
+    {
+        BuildFilterBank(stages);
+
+        pyramid.waveletCoeffs.resize(stages);
+        pyramid.scalingCoeffs.resize(stages);
+        for (int i = 0; i < stages; i++)
         {
-            waveletCoeffs[basisIdx] = operations.ComputeDotProduct(inputSignal, waveletBasis[basisIdx]);
-            scalingCoeffs[basisIdx] = operations.ComputeDotProduct(inputSignal, scalingBasis[basisIdx]);
+            const std::vector<Sample>& approximation = (i == 0) ? inputSignal : pyramid.scalingCoeffs[i - 1];
+            AtrousAnalysisStep(highpassBank[i], 1 << i, approximation, pyramid.waveletCoeffs[i]);
+            AtrousAnalysisStep(lowpassBank[i], 1 << i, approximation, pyramid.scalingCoeffs[i]);
         }
     }
 
-    // ���� �������: �������������� ������� �� �������������
-    void WaveletProcessor::PerformReconstruction(int stage,
-        const std::vector<std::complex<double>>& waveletCoeffs,
-        const std::vector<std::complex<double>>& scalingCoeffs,
-        std::vector<std::complex<double>>& lowpassPart,
-        std::vector<std::complex<double>>& highpassPart,
-        std::vector<std::complex<double>>& reconstructedSignal)
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::PerformStationaryReconstruction(int stages,
+        const DecompositionPyramid& pyramid,
+        std::vector<Sample>& output)
     {
-        std::vector<std::vector<std::complex<double>>> waveletBasis, scalingBasis;
-        GenerateBasisFunctions(stage, waveletBasis, scalingBasis);
+        BuildFilterBank(stages);
 
-        int basisElements = (int)waveletBasis.size();
-        int dataSize = (int)lowpassFilter.size();
+        WorkspacePool& workspace = WorkspacePool::ForThread();
+        WorkspacePool::Scope scope(workspace);
+        std::vector<Sample>& approximation = workspace.Acquire<Sample>(0);
+        approximation.assign(pyramid.scalingCoeffs[stages - 1].begin(), pyramid.scalingCoeffs[stages - 1].end());
+        for (int i = stages - 1; i >= 0; i--)
+        {
+            output.assign(approximation.size(), Sample(0.0));
+            AtrousSynthesisStep(lowpassBank[i], 1 << i, approximation, output);
+            AtrousSynthesisStep(highpassBank[i], 1 << i, pyramid.waveletCoeffs[i], output);
+            approximation.swap(output);
+        }
+        output.swap(approximation);
+    }
 
-        lowpassPart.assign(dataSize, std::complex<double>(0.0, 0.0));
-        highpassPart.assign(dataSize, std::complex<double>(0.0, 0.0));
-        reconstructedSignal.assign(dataSize, std::complex<double>(0.0, 0.0));
+    // Рабочие буферы строки заводятся один раз на поток; банк фильтров к этому моменту построен
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::FilterRows2D(Sample* data, int stride, int size, int level, bool forward)
+    {
+        const BankFilter& lowpass = lowpassBank[level - 1];
+        const BankFilter& highpass = highpassBank[level - 1];
+        int half = size / 2;
 
-        for (int dataIdx = 0; dataIdx < dataSize; dataIdx++)
+        Parallel::ForRange(0, size, [&](int firstRow, int lastRow)
+        {
+            WorkspacePool& workspace = WorkspacePool::ForThread();
+            WorkspacePool::Scope scope(workspace);
+            std::vector<Sample>& row = workspace.Acquire<Sample>(size);
+            std::vector<Sample>& lowPart = workspace.Acquire<Sample>(half);
+            std::vector<Sample>& highPart = workspace.Acquire<Sample>(half);
+            std::vector<Sample>& contribution = workspace.Acquire<Sample>(size);
+            for (int r = firstRow; r < lastRow; r++)
+            {
+                Sample* line = data + (long long)r * stride;
+                if (forward)
+                {
+                    std::copy(line, line + size, row.begin());
+                    AnalysisStep(lowpass, row, lowPart);
+                    AnalysisStep(highpass, row, highPart);
+                    std::copy(lowPart.begin(), lowPart.end(), line);
+                    std::copy(highPart.begin(), highPart.end(), line + half);
+                }
+                else
+                {
+                    std::copy(line, line + half, lowPart.begin());
+                    std::copy(line + half, line + size, highPart.begin());
+                    SynthesisStep(lowpass, lowPart, row);
+                    SynthesisStep(highpass, highPart, contribution);
+                    for (int i = 0; i < size; i++)
+                        line[i] = row[i] + contribution[i];
+                }
+            }
+        }, 16);
+    }
+
+    // Строчный и столбцовый проходы коммутируют, поэтому порядок одинаков для анализа и синтеза
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::ProcessLevel2D(std::vector<Sample>& image, std::vector<Sample>& transposed,
+        int level, bool forward)
+    {
+        int N = (int)lowpassFilter.size();
+        int size = N >> (level - 1);
+
+        FilterRows2D(image.data(), N, size, level, forward);
+        TransposeBlocked(image.data(), N, transposed.data(), size, size, size);
+        FilterRows2D(transposed.data(), size, size, level, forward);
+        TransposeBlocked(transposed.data(), size, image.data(), N, size, size);
+    }
+
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::PerformDecomposition2D(int stages, std::vector<Sample>& image)
+    {
+        int N = (int)lowpassFilter.size();
+        if ((long long)image.size() != (long long)N * N)
+            throw std::runtime_error("Размер изображения не совпадает с размером процессора");
+
+        BuildFilterBank(stages);
+        WorkspacePool& workspace = WorkspacePool::ForThread();
+        WorkspacePool::Scope scope(workspace);
+        std::vector<Sample>& transposed = workspace.Acquire<Sample>((size_t)N * N);
+        for (int level = 1; level <= stages; level++)
+            ProcessLevel2D(image, transposed, level, true);
+    }
+
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::PerformReconstruction2D(int stages, std::vector<Sample>& image)
+    {
+        int N = (int)lowpassFilter.size();
+        if ((long long)image.size() != (long long)N * N)
+            throw std::runtime_error("Размер изображения не совпадает с размером процессора");
+
+        BuildFilterBank(stages);
+        WorkspacePool& workspace = WorkspacePool::ForThread();
+        WorkspacePool::Scope scope(workspace);
+        std::vector<Sample>& transposed = workspace.Acquire<Sample>((size_t)N * N);
+        for (int level = stages; level >= 1; level--)
+            ProcessLevel2D(image, transposed, level, false);
+    }
+
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::ExtractSubband2D(const std::vector<Sample>& image, int level, Subband band,
+        std::vector<Sample>& subband) const
+    {
+        int N = (int)lowpassFilter.size();
+        int size = N >> level;
+        int rowOffset = (band == Subband::LH || band == Subband::HH) ? size : 0;
+        int colOffset = (band == Subband::HL || band == Subband::HH) ? size : 0;
+
+        subband.resize((size_t)size * size);
+        for (int r = 0; r < size; r++)
+        {
+            const Sample* line = image.data() + (long long)(rowOffset + r) * N + colOffset;
+            std::copy(line, line + size, subband.begin() + (long long)r * size);
+        }
+    }
+
+    template <typename Sample>
+    double BasicWaveletProcessor<Sample>::PerformDenoising(int stages, std::vector<Sample>& signal,
+        ThresholdRule rule, ThresholdSelection selection)
+    {
+        if (mode == TransformMode::Lifting)
+            return DenoiseByLifting(stages, signal, rule, selection);
+
+        // Пирамида проекционного режима совпадает с пирамидой банка фильтров,
+        // поэтому восстановление в обоих режимах идёт быстрым каскадом
+        int N = (int)signal.size();
+        DecompositionPyramid& pyramid = workspacePyramid;
+        PerformMultilevelDecomposition(stages, signal, pyramid);
+
+        double sigma = EstimateNoiseLevel(pyramid.waveletCoeffs[0].data(), (int)pyramid.waveletCoeffs[0].size(), 1);
+        for (int level = 1; level <= stages; level++)
+        {
+            std::vector<Sample>& details = pyramid.waveletCoeffs[level - 1];
+            ThresholdLevel(details.data(), (int)details.size(), 1, sigma, N, rule, selection);
+        }
+
+        ReconstructFromPyramid(stages, pyramid, signal);
+        return sigma;
+    }
+
+    // Прямой лифтинг, порог и обратный лифтинг в одном буфере: d_s[k] = data[(2k + 1) * 2^(s - 1)].
+    // Вещественный сигнал преобразуется прямо в signal, комплексный - через буферы
+    // вещественной и мнимой частей, коэффициенты собираются в signal на время пороговой обработки
+    template <typename Sample>
+    double BasicWaveletProcessor<Sample>::DenoiseByLifting(int stages, std::vector<Sample>& signal,
+        ThresholdRule rule, ThresholdSelection selection)
+    {
+        int N = (int)signal.size();
+        WorkspacePool& workspace = WorkspacePool::ForThread();
+        WorkspacePool::Scope scope(workspace);
+        std::vector<double>& realPart = workspace.Acquire<double>(0);
+        std::vector<double>& imagPart = workspace.Acquire<double>(0);
+
+        if constexpr (std::is_same<Sample, double>::value)
+        {
+            for (int level = 1; level <= stages; level++)
+                ApplyLiftingLevel(signal, level, true);
+        }
+        else
+        {
+            realPart.resize(N);
+            imagPart.resize(N);
+            for (int i = 0; i < N; i++)
+            {
+                realPart[i] = SampleTraits<Sample>::Real(signal[i]);
+                imagPart[i] = SampleTraits<Sample>::Imag(signal[i]);
+            }
+            for (int level = 1; level <= stages; level++)
+            {
+                ApplyLiftingLevel(realPart, level, true);
+                ApplyLiftingLevel(imagPart, level, true);
+            }
+            for (int i = 0; i < N; i++)
+                signal[i] = SampleTraits<Sample>::Compose(realPart[i], imagPart[i]);
+        }
+
+        double sigma = EstimateNoiseLevel(signal.data() + 1, N / 2, 2);
+        for (int level = 1; level <= stages; level++)
+            ThresholdLevel(signal.data() + (1 << (level - 1)), N >> level, 1 << level, sigma, N, rule, selection);
+
+        if constexpr (std::is_same<Sample, double>::value)
+        {
+            for (int level = stages; level >= 1; level--)
+                ApplyLiftingLevel(signal, level, false);
+        }
+        else
+        {
+            for (int i = 0; i < N; i++)
+            {
+                realPart[i] = SampleTraits<Sample>::Real(signal[i]);
+                imagPart[i] = SampleTraits<Sample>::Imag(signal[i]);
+            }
+            for (int level = stages; level >= 1; level--)
+            {
+                ApplyLiftingLevel(realPart, level, false);
+                ApplyLiftingLevel(imagPart, level, false);
+            }
+            for (int i = 0; i < N; i++)
+                signal[i] = SampleTraits<Sample>::Compose(realPart[i], imagPart[i]);
+        }
+
+        return sigma;
+    }
+
+    // Выбор наилучшего базиса снизу вверх: узел остаётся, если он не дороже лучших потомков
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::SelectBestBasis(WaveletPacketTree& tree, double signalEnergy)
+    {
+        int stages = (int)tree.nodes.size() - 1;
+        if (signalEnergy <= 0.0)
+        {
+            tree.bestBasis.push_back(std::make_pair(0, 0));
+            return;
+        }
+
+        std::vector<std::vector<double>> bestCost(stages + 1);
+        std::vector<std::vector<bool>> keepNode(stages + 1);
+
+        for (int level = stages; level >= 0; level--)
+        {
+            int nodeCount = 1 << level;
+            bestCost[level].resize(nodeCount);
+            keepNode[level].assign(nodeCount, true);
+
+            for (int index = 0; index < nodeCount; index++)
+            {
+                double nodeCost = ComputeEntropyCost(tree.nodes[level][index], signalEnergy);
+                bestCost[level][index] = nodeCost;
+                if (level == stages)
+                    continue;
+
+                double childrenCost = bestCost[level + 1][2 * index] + bestCost[level + 1][2 * index + 1];
+                if (childrenCost < nodeCost)
+                {
+                    bestCost[level][index] = childrenCost;
+                    keepNode[level][index] = false;
+                }
+            }
+        }
+
+        std::vector<std::pair<int, int>> pending(1, std::make_pair(0, 0));
+        while (!pending.empty())
+        {
+            std::pair<int, int> node = pending.back();
+            pending.pop_back();
+
+            if (keepNode[node.first][node.second])
+            {
+                tree.bestBasis.push_back(node);
+                continue;
+            }
+
+            pending.push_back(std::make_pair(node.first + 1, 2 * node.second + 1));
+            pending.push_back(std::make_pair(node.first + 1, 2 * node.second));
+        }
+    }
+
+    // Один уровень лифтинга по месту: уровень level работает с отсчётами шага 2^(level - 1)
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::ApplyLiftingLevel(std::vector<double>& data, int level, bool forward)
+    {
+        int count = (int)data.size() >> (level - 1);
+        int stride = 1 << (level - 1);
+
+        switch (waveletType)
+        {
+        case WaveletType::Haar:
+            if (forward) LiftingWavelet<WaveletFamilies::Haar>::Forward(data.data(), count, stride);
+            else LiftingWavelet<WaveletFamilies::Haar>::Inverse(data.data(), count, stride);
+            break;
+        case WaveletType::Daubechies6:
+            if (forward) LiftingWavelet<WaveletFamilies::Daubechies6>::Forward(data.data(), count, stride);
+            else LiftingWavelet<WaveletFamilies::Daubechies6>::Inverse(data.data(), count, stride);
+            break;
+        default:
+            throw std::runtime_error("Лифтинг-схема доступна только для вейвлетов с компактным носителем");
+        }
+    }
+
+    // Вещественная и мнимая части преобразуются независимо (фильтры вещественные);
+    // для вещественного Sample буфер мнимой части не заводится
+    // В pyramid должно быть не меньше stages уровней: размер задаёт вызывающий
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::DecomposeByLifting(int stages,
+        const std::vector<Sample>& inputSignal,
+        DecompositionPyramid& pyramid)
+    {
+        int N = (int)inputSignal.size();
+        WorkspacePool& workspace = WorkspacePool::ForThread();
+        WorkspacePool::Scope scope(workspace);
+        std::vector<double>& realPart = workspace.Acquire<double>(N);
+        std::vector<double>& imagPart = workspace.Acquire<double>(0);
+        bool hasImaginary = false;
+        for (int i = 0; i < N; i++)
+        {
+            realPart[i] = SampleTraits<Sample>::Real(inputSignal[i]);
+            if (SampleTraits<Sample>::Imag(inputSignal[i]) != 0.0) hasImaginary = true;
+        }
+
+        if (hasImaginary)
         {
-            std::complex<double> lowpassComponent(0.0, 0.0);
-            std::complex<double> highpassComponent(0.0, 0.0);
+            imagPart.resize(N);
+            for (int i = 0; i < N; i++)
+                imagPart[i] = SampleTraits<Sample>::Imag(inputSignal[i]);
+        }
 
-            for (int basisIdx = 0; basisIdx < basisElements; basisIdx++)
+        for (int level = 1; level <= stages; level++)
+        {
+            ApplyLiftingLevel(realPart, level, true);
+            if (hasImaginary)
+                ApplyLiftingLevel(imagPart, level, true);
+
+            int count = N >> level;
+            pyramid.waveletCoeffs[level - 1].resize(count);
+            pyramid.scalingCoeffs[level - 1].resize(count);
+            for (int k = 0; k < count; k++)
             {
-                lowpassComponent = lowpassComponent + (scalingCoeffs[basisIdx] * scalingBasis[basisIdx][dataIdx]);
-                highpassComponent = highpassComponent + (waveletCoeffs[basisIdx] * waveletBasis[basisIdx][dataIdx]);
+                int scalingIdx = k << level;
+                int waveletIdx = (2 * k + 1) << (level - 1);
+                pyramid.scalingCoeffs[level - 1][k] = SampleTraits<Sample>::Compose(realPart[scalingIdx],
+                    hasImaginary ? imagPart[scalingIdx] : 0.0);
+                pyramid.waveletCoeffs[level - 1][k] = SampleTraits<Sample>::Compose(realPart[waveletIdx],
+                    hasImaginary ? imagPart[waveletIdx] : 0.0);
             }
+        }
+    }
 
-            lowpassPart[dataIdx] = lowpassComponent;
-            highpassPart[dataIdx] = highpassComponent;
-            reconstructedSignal[dataIdx] = lowpassComponent + highpassComponent;
+    // Вклад НЧ (scalingPart) или ВЧ коэффициентов уровня stage: обратный лифтинг от нулевого буфера
+    template <typename Sample>
+    void BasicWaveletProcessor<Sample>::SynthesizeByLifting(int stage, bool scalingPart,
+        const std::vector<Sample>& coeffs,
+        std::vector<Sample>& result)
+    {
+        int N = (int)lowpassFilter.size();
+        WorkspacePool& workspace = WorkspacePool::ForThread();
+        WorkspacePool::Scope scope(workspace);
+        std::vector<double>& realPart = workspace.Acquire<double>(N);
+        std::vector<double>& imagPart = workspace.Acquire<double>(0);
+        std::fill(realPart.begin(), realPart.end(), 0.0);
+        bool hasImaginary = false;
+
+        for (int k = 0; k < (int)coeffs.size(); k++)
+        {
+            realPart[scalingPart ? (k << stage) : ((2 * k + 1) << (stage - 1))] = SampleTraits<Sample>::Real(coeffs[k]);
+            if (SampleTraits<Sample>::Imag(coeffs[k]) != 0.0) hasImaginary = true;
+        }
+
+        if (hasImaginary)
+        {
+            imagPart.assign(N, 0.0);
+            for (int k = 0; k < (int)coeffs.size(); k++)
+                imagPart[scalingPart ? (k << stage) : ((2 * k + 1) << (stage - 1))] = SampleTraits<Sample>::Imag(coeffs[k]);
         }
+
+        for (int level = stage; level >= 1; level--)
+        {
+            ApplyLiftingLevel(realPart, level, false);
+            if (hasImaginary)
+                ApplyLiftingLevel(imagPart, level, false);
+        }
+
+        result.resize(N);
+        for (int i = 0; i < N; i++)
+            result[i] = SampleTraits<Sample>::Compose(realPart[i], hasImaginary ? imagPart[i] : 0.0);
     }
+
+    template class BasicWaveletProcessor<double>;
+    template class BasicWaveletProcessor<std::complex<double>>;
 }
\ No newline at end of file
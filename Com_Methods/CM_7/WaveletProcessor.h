@@ -4,17 +4,16 @@
 
 #include <vector>
 #include <complex>
+#include <utility>
 #include "SignalOperations.h"
 #include "SignalTransformer.h"
+#include "SampleTraits.h"
 
 namespace SignalProcessing
 {
-    class WaveletProcessor
+    // Перечисления, общие для вещественного и комплексного вариантов
+    class WaveletProcessorTypes
     {
-    private:
-        std::vector<std::complex<double>> lowpassFilter, highpassFilter;
-        std::vector<std::vector<std::complex<double>>> decompositionFilters, reconstructionFilters;
-
     public:
         enum class WaveletType
         {
@@ -23,28 +22,248 @@ namespace SignalProcessing
             Daubechies6 = 3
         };
 
-        WaveletProcessor(int dataSize, WaveletType type);
+        // BasisProjection - скалярные произведения со сдвинутыми базисными векторами, O(N^2);
+        // FilterBank - каскад Малла (свёртка + прореживание), O(N*L);
+        // Lifting - лифтинг-схема по месту над вещественными частями (только Haar и Daubechies6)
+        enum class TransformMode
+        {
+            BasisProjection = 1,
+            FilterBank = 2,
+            Lifting = 3
+        };
+
+        // Hard - обнуление |d| <= lambda; Soft - модуль коэффициента уменьшается на lambda
+        enum class ThresholdRule
+        {
+            Hard = 1,
+            Soft = 2
+        };
+
+        // Universal - sigma * sqrt(2 ln N) (VisuShrink); SURE - минимум несмещённой оценки риска
+        // Стейна по уровню (с переходом к универсальному порогу для разреженных уровней);
+        // BayesShrink - sigma^2 / sigma_x по дисперсии коэффициентов уровня
+        enum class ThresholdSelection
+        {
+            Universal = 1,
+            SURE = 2,
+            BayesShrink = 3
+        };
+
+        // Подполосы двумерного разложения: первая буква - фильтр вдоль строк, вторая - вдоль столбцов
+        enum class Subband
+        {
+            LL = 0,
+            HL = 1,
+            LH = 2,
+            HH = 3
+        };
+    };
+
+    // Sample = double для вещественных сигналов (Haar, Daubechies6),
+    // Sample = std::complex<double> - для комплексного фильтра Шеннона
+    template <typename Sample>
+    class BasicWaveletProcessor : public WaveletProcessorTypes
+    {
+    public:
+        // Пирамида многоуровневого разложения: элемент [s - 1] - коэффициенты уровня s
+        struct DecompositionPyramid
+        {
+            std::vector<std::vector<Sample>> waveletCoeffs;
+            std::vector<std::vector<Sample>> scalingCoeffs;
+        };
+
+        // Дерево вейвлет-пакетов: nodes[level][index], у узла index потомки 2*index (НЧ) и 2*index + 1 (ВЧ)
+        struct WaveletPacketTree
+        {
+            std::vector<std::vector<std::vector<Sample>>> nodes;
+            std::vector<std::pair<int, int>> bestBasis; // (level, index) узлов наилучшего базиса
+        };
+
+        // Кратномасштабный анализ на исходной сетке: approximations[s - 1] = P_s, details[s - 1] = Q_s,
+        // P_0 - входной сигнал, P_(s-1) = P_s + Q_s
+        struct MultiresolutionComponents
+        {
+            std::vector<std::vector<Sample>> approximations;
+            std::vector<std::vector<Sample>> details;
+        };
+
+    private:
+        // Фильтр уровня банка, периодизированный на длину N / 2^stage
+        struct BankFilter
+        {
+            std::vector<int> tapPositions;
+            std::vector<Sample> tapValues;
+            std::vector<std::complex<double>> spectrum; // только для плотных фильтров
+        };
+
+        WaveletType waveletType;
+        TransformMode mode;
+        std::vector<Sample> lowpassFilter, highpassFilter;
+        std::vector<std::vector<Sample>> decompositionFilters, reconstructionFilters;
+        std::vector<std::vector<std::complex<double>>> reconstructionSpectra;
+        std::vector<BankFilter> lowpassBank, highpassBank;
+
+        // Рабочая пирамида лифтинга в PerformDecomposition и пирамида PerformDenoising:
+        // живёт вместе с процессором, чтобы повторные вызовы не выделяли память
+        DecompositionPyramid workspacePyramid;
+
+    public:
+        BasicWaveletProcessor(int dataSize, WaveletType type, TransformMode transformMode = TransformMode::FilterBank);
 
     private:
         void BuildFilterSystem(int stages);
 
-        void GenerateBasisFunctions(int stage,
-            std::vector<std::vector<std::complex<double>>>& waveletBasis,
-            std::vector<std::vector<std::complex<double>>>& scalingBasis);
+        void BuildFilterBank(int stages);
+
+        void PeriodizeFilter(const std::vector<Sample>& filter, int length, BankFilter& result);
+
+        void AnalysisStep(const BankFilter& filter,
+            const std::vector<Sample>& input,
+            std::vector<Sample>& output);
+
+        void SynthesisStep(const BankFilter& filter,
+            const std::vector<Sample>& input,
+            std::vector<Sample>& output);
+
+        void SynthesizeToSignal(int stage, const BankFilter& firstFilter,
+            const std::vector<Sample>& coeffs,
+            std::vector<Sample>& result);
 
     public:
         void PerformDecomposition(int stage,
-            const std::vector<std::complex<double>>& inputSignal,
-            std::vector<std::complex<double>>& waveletCoeffs,
-            std::vector<std::complex<double>>& scalingCoeffs);
+            const std::vector<Sample>& inputSignal,
+            std::vector<Sample>& waveletCoeffs,
+            std::vector<Sample>& scalingCoeffs);
 
         void PerformReconstruction(int stage,
-            const std::vector<std::complex<double>>& waveletCoeffs,
-            const std::vector<std::complex<double>>& scalingCoeffs,
-            std::vector<std::complex<double>>& lowpassPart,
-            std::vector<std::complex<double>>& highpassPart,
-            std::vector<std::complex<double>>& reconstructedSignal);
+            const std::vector<Sample>& waveletCoeffs,
+            const std::vector<Sample>& scalingCoeffs,
+            std::vector<Sample>& lowpassPart,
+            std::vector<Sample>& highpassPart,
+            std::vector<Sample>& reconstructedSignal);
+
+        // Все уровни 1..stages за один проход: каждый уровень раскладывает НЧ-коэффициенты предыдущего
+        void PerformMultilevelDecomposition(int stages,
+            const std::vector<Sample>& inputSignal,
+            DecompositionPyramid& pyramid);
+
+        // Полное дерево вейвлет-пакетов глубины stages; при selectBestBasis - выбор базиса по энтропии
+        void PerformPacketDecomposition(int stages,
+            const std::vector<Sample>& inputSignal,
+            WaveletPacketTree& tree,
+            bool selectBestBasis = true);
+
+        // P и Q всех уровней 1..stages из одного разложения: Q_s синтезируется из ВЧ-коэффициентов
+        // уровня s, P_s = P_(s-1) - Q_s получается из предыдущего уровня
+        void PerformMultiresolutionAnalysis(int stages,
+            const std::vector<Sample>& inputSignal,
+            DecompositionPyramid& pyramid,
+            MultiresolutionComponents& components);
+
+        // Подавление шума по месту: прямое преобразование на stages уровней, пороговая обработка
+        // ВЧ-коэффициентов каждого уровня и обратное преобразование. Уровень шума sigma оценивается
+        // по самому мелкому уровню (медиана |d_1| / 0.6745) и возвращается.
+        // В режиме Lifting коэффициенты обрабатываются прямо в буфере сигнала
+        double PerformDenoising(int stages, std::vector<Sample>& signal,
+            ThresholdRule rule, ThresholdSelection selection);
+
+        // Стационарное (неразреженное) разложение алгоритмом a trous: фильтр уровня s разрежен
+        // вставкой 2^(s - 1) - 1 нулей между отводами, прореживания нет, все уровни длины N.
+        // Коэффициенты обычного разложения сигнала, сдвинутого на tau отсчётов влево,
+        // - это waveletCoeffs[s - 1][(k * 2^s + tau) mod N]: все сдвиги за O(N * stages)
+        void PerformStationaryDecomposition(int stages,
+            const std::vector<Sample>& inputSignal,
+            DecompositionPyramid& pyramid);
+
+        // Двумерное разложение изображения N x N (по строкам, N - размер процессора) по месту.
+        // На уровне s обрабатывается квадрант n = N >> (s - 1): строки, затем столбцы через
+        // транспонирование плитками; после уровня LL занимает [0, n/2) x [0, n/2), HL - правый верхний,
+        // LH - левый нижний, HH - правый нижний квадрант. Строки и столбцы делятся между потоками.
+        // Двумерные преобразования всегда выполняются банком фильтров
+        void PerformDecomposition2D(int stages, std::vector<Sample>& image);
+
+        void PerformReconstruction2D(int stages, std::vector<Sample>& image);
+
+        // Копия подполосы уровня level из разложенного изображения ((N >> level)^2 отсчётов);
+        // LL содержит коэффициенты только для последнего уровня разложения
+        void ExtractSubband2D(const std::vector<Sample>& image, int level, Subband band,
+            std::vector<Sample>& subband) const;
+
+        // Обратное стационарное преобразование: a_(s-1) = (H* a_s + G* d_s) / 2
+        void PerformStationaryReconstruction(int stages,
+            const DecompositionPyramid& pyramid,
+            std::vector<Sample>& output);
+
+    private:
+        void SelectBestBasis(WaveletPacketTree& tree, double signalEnergy);
+
+        // Шаги a trous с фильтром банка, разреженным в dilation раз (длина сигнала не меняется);
+        // синтез прибавляет половину вклада к output
+        void AtrousAnalysisStep(const BankFilter& filter, int dilation,
+            const std::vector<Sample>& input,
+            std::vector<Sample>& output);
+
+        void AtrousSynthesisStep(const BankFilter& filter, int dilation,
+            const std::vector<Sample>& input,
+            std::vector<Sample>& output);
+
+        // Анализ (forward) или синтез строк квадранта size x size с шагом строки stride
+        // фильтрами банка уровня level: НЧ-половина строки слева, ВЧ - справа
+        void FilterRows2D(Sample* data, int stride, int size, int level, bool forward);
+
+        // Один уровень по строкам и столбцам квадранта size x size в начале изображения
+        void ProcessLevel2D(std::vector<Sample>& image, std::vector<Sample>& transposed, int level, bool forward);
+
+        // Обратный каскад банка фильтров от пирамиды к сигналу
+        void ReconstructFromPyramid(int stages,
+            const DecompositionPyramid& pyramid,
+            std::vector<Sample>& output);
+
+        double DenoiseByLifting(int stages, std::vector<Sample>& signal,
+            ThresholdRule rule, ThresholdSelection selection);
+
+        // Вклад ВЧ-коэффициентов уровня stage в сигнал (Q_stage) в текущем режиме
+        void SynthesizeDetail(int stage,
+            const std::vector<Sample>& waveletCoeffs,
+            std::vector<Sample>& detail);
+
+        void ApplyLiftingLevel(std::vector<double>& data, int level, bool forward);
+
+        void DecomposeByLifting(int stages,
+            const std::vector<Sample>& inputSignal,
+            DecompositionPyramid& pyramid);
+
+        void SynthesizeByLifting(int stage, bool scalingPart,
+            const std::vector<Sample>& coeffs,
+            std::vector<Sample>& result);
+
+        void DecomposeByProjection(int stage,
+            const std::vector<Sample>& inputSignal,
+            std::vector<Sample>& waveletCoeffs,
+            std::vector<Sample>& scalingCoeffs);
+
+        void ReconstructByProjection(int stage,
+            const std::vector<Sample>& waveletCoeffs,
+            const std::vector<Sample>& scalingCoeffs,
+            std::vector<Sample>& lowpassPart,
+            std::vector<Sample>& highpassPart,
+            std::vector<Sample>& reconstructedSignal);
+
+        void DecomposeByFilterBank(int stage,
+            const std::vector<Sample>& inputSignal,
+            std::vector<Sample>& waveletCoeffs,
+            std::vector<Sample>& scalingCoeffs);
+
+        void ReconstructByFilterBank(int stage,
+            const std::vector<Sample>& waveletCoeffs,
+            const std::vector<Sample>& scalingCoeffs,
+            std::vector<Sample>& lowpassPart,
+            std::vector<Sample>& highpassPart,
+            std::vector<Sample>& reconstructedSignal);
     };
+
+    using WaveletProcessor = BasicWaveletProcessor<std::complex<double>>;
+    using RealWaveletProcessor = BasicWaveletProcessor<double>;
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+#ifndef WORKSPACE_POOL_H
+#define WORKSPACE_POOL_H
+
+#include <complex>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace SignalProcessing
+{
+    // Арена рабочих буферов преобразований. Acquire выдаёт очередной свободный буфер нужного типа
+    // длины count; буферы не освобождаются, а сохраняют ёмкость до следующего вызова.
+    // Scope работает как метка стека: буферы, выданные внутри области, возвращаются при выходе.
+    // После первого прогона на тех же длинах повторные вызовы не обращаются к куче
+    class WorkspacePool
+    {
+    private:
+        template <typename T>
+        struct Slots
+        {
+            std::deque<std::vector<T>> buffers; // deque: ссылки на выданные буферы не инвалидируются
+            size_t used = 0;
+        };
+
+        Slots<double> realSlots;
+        Slots<std::complex<double>> complexSlots;
+
+        template <typename T>
+        Slots<T>& SlotsOf();
+
+    public:
+        class Scope
+        {
+        private:
+            WorkspacePool& pool;
+            size_t realMark, complexMark;
+
+        public:
+            explicit Scope(WorkspacePool& workspace)
+                : pool(workspace),
+                realMark(workspace.realSlots.used),
+                complexMark(workspace.complexSlots.used)
+            {
+            }
+
+            ~Scope()
+            {
+                pool.realSlots.used = realMark;
+                pool.complexSlots.used = complexMark;
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        };
+
+        // Содержимое буфера не определено: это остатки предыдущего использования
+        template <typename T>
+        std::vector<T>& Acquire(size_t count)
+        {
+            Slots<T>& slots = SlotsOf<T>();
+            if (slots.used == slots.buffers.size())
+                slots.buffers.emplace_back();
+
+            std::vector<T>& buffer = slots.buffers[slots.used++];
+            buffer.resize(count);
+            return buffer;
+        }
+
+        // Все буферы снова свободны (ёмкость сохраняется)
+        void Reset()
+        {
+            realSlots.used = 0;
+            complexSlots.used = 0;
+        }
+
+        // Своя арена у каждого потока: параллельные проходы не делят буферы
+        static WorkspacePool& ForThread()
+        {
+            thread_local WorkspacePool pool;
+            return pool;
+        }
+    };
+
+    template <>
+    inline WorkspacePool::Slots<double>& WorkspacePool::SlotsOf<double>() { return realSlots; }
+
+    template <>
+    inline WorkspacePool::Slots<std::complex<double>>& WorkspacePool::SlotsOf<std::complex<double>>() { return complexSlots; }
+}
+
+#endif
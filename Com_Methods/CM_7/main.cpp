@@ -1,65 +1,91 @@
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <complex>
 #include <cmath>
-#include <random>
+#include <exception>
 #include <string>
 #include <fstream>
 #include <iomanip>
-#include <chrono>
+#include <functional>
+#include <future>
 
 #include "WaveletProcessor.h"
+#include "ConvolutionEngine.h"
+#include "FourierCore.h"
+#include "SignalTransformer.h"
 #include "MathConstants.h"
-constexpr double PI = 3.14159265358979323846;
-
-static void SaveSignalToCSV(const std::string& filepath, const std::vector<std::complex<double>>& signal)
+#include "AllocationCounter.h"
+#include "ParallelFor.h"
+#include "BackgroundWriter.h"
+#include "NumericTextWriter.h"
+#include "NpyWriter.h"
+#include "SignalSynthesis.h"
+
+// С SIGNAL_PROCESSING_KERNEL_CHECK программа собирается как сверка ядер (ComplexKernelsCheck.cpp)
+#ifndef SIGNAL_PROCESSING_KERNEL_CHECK
+
+// CSV остаются для старых скриптов; графикам CM1-CM3 достаточно wavelet_sweep.npz
+constexpr bool WRITE_CSV_FILES = true;
+
+// Писатели CSV принимают вещественные и комплексные отсчёты; формат файлов общий.
+// Числа пишутся кратчайшей записью, однозначно восстанавливающей double
+template <typename Sample>
+static void SaveSignalToCSV(const std::string& filepath, const std::vector<Sample>& signal)
 {
-    std::ofstream file(filepath);
-    file << "index,real_part,imag_part\n";
+    using Traits = SignalProcessing::SampleTraits<Sample>;
+    SignalProcessing::NumericTextWriter file(filepath);
+    file.Text("index,real_part,imag_part\n");
     for (int i = 0; i < (int)signal.size(); i++)
-        file << i << "," << std::setprecision(17) << signal[i].real() << "," << signal[i].imag() << "\n";
+        file.Column(i).Column(Traits::Real(signal[i])).Column(Traits::Imag(signal[i])).EndRow();
 }
 
+template <typename Sample>
 static void SaveCoefficientsToCSV(const std::string& filepath, int stage,
-    const std::vector<std::complex<double>>& psiCoeffs,
-    const std::vector<std::complex<double>>& phiCoeffs)
+    const std::vector<Sample>& psiCoeffs,
+    const std::vector<Sample>& phiCoeffs)
 {
-    std::ofstream file(filepath);
-    file << "k,index,psi_real,psi_imag,phi_real,phi_imag,psi_magnitude,phi_magnitude\n";
+    using Traits = SignalProcessing::SampleTraits<Sample>;
+    SignalProcessing::NumericTextWriter file(filepath);
+    file.Text("k,index,psi_real,psi_imag,phi_real,phi_imag,psi_magnitude,phi_magnitude\n");
     for (int k = 0; k < (int)psiCoeffs.size(); k++)
     {
-        int idx = (int)(std::pow(2.0, stage) * k);
-        file << k << "," << idx << ","
-            << std::setprecision(17) << psiCoeffs[k].real() << "," << psiCoeffs[k].imag() << ","
-            << phiCoeffs[k].real() << "," << phiCoeffs[k].imag() << ","
-            << std::abs(psiCoeffs[k]) << "," << std::abs(phiCoeffs[k]) << "\n";
+        int idx = k << stage;
+        file.Column(k).Column(idx)
+            .Column(Traits::Real(psiCoeffs[k])).Column(Traits::Imag(psiCoeffs[k]))
+            .Column(Traits::Real(phiCoeffs[k])).Column(Traits::Imag(phiCoeffs[k]))
+            .Column(std::abs(psiCoeffs[k])).Column(std::abs(phiCoeffs[k])).EndRow();
     }
 }
 
+template <typename Sample>
 static void SaveFilterResultsToCSV(const std::string& filepath,
-    const std::vector<std::complex<double>>& original,
-    const std::vector<std::complex<double>>& filtered,
-    const std::vector<std::complex<double>>& difference)
+    const std::vector<Sample>& original,
+    const std::vector<Sample>& filtered,
+    const std::vector<Sample>& difference)
 {
-    std::ofstream file(filepath);
-    file << "index,original_real,filtered_real,difference_real\n";
+    using Traits = SignalProcessing::SampleTraits<Sample>;
+    SignalProcessing::NumericTextWriter file(filepath);
+    file.Text("index,original_real,filtered_real,difference_real\n");
     for (int i = 0; i < (int)original.size(); i++)
-        file << i << "," << std::setprecision(17)
-        << original[i].real() << ","
-        << filtered[i].real() << ","
-        << difference[i].real() << "\n";
+        file.Column(i)
+            .Column(Traits::Real(original[i]))
+            .Column(Traits::Real(filtered[i]))
+            .Column(Traits::Real(difference[i])).EndRow();
 }
 
+template <typename Sample>
 static void SavePQComponentsToCSV(const std::string& filepath,
-    const std::vector<std::complex<double>>& PComponent,
-    const std::vector<std::complex<double>>& QComponent)
+    const std::vector<Sample>& PComponent,
+    const std::vector<Sample>& QComponent)
 {
-    std::ofstream file(filepath);
-    file << "index,P_real,Q_real\n";
+    using Traits = SignalProcessing::SampleTraits<Sample>;
+    SignalProcessing::NumericTextWriter file(filepath);
+    file.Text("index,P_real,Q_real\n");
     for (int i = 0; i < (int)PComponent.size(); i++)
-        file << i << "," << std::setprecision(17)
-        << PComponent[i].real() << ","
-        << QComponent[i].real() << "\n";
+        file.Column(i)
+            .Column(Traits::Real(PComponent[i]))
+            .Column(Traits::Real(QComponent[i])).EndRow();
 }
 
 static std::string GetWaveletName(SignalProcessing::WaveletProcessor::WaveletType type)
@@ -70,96 +96,270 @@ static std::string GetWaveletName(SignalProcessing::WaveletProcessor::WaveletTyp
     return "d6";
 }
 
-static void ComputeOnlyPComponent(SignalProcessing::WaveletProcessor& processor,
-    int stage,
-    const std::vector<std::complex<double>>& signal,
-    std::vector<std::complex<double>>& PComponent)
-{
-    std::vector<std::complex<double>> psiCoeffs, phiCoeffs;
-    processor.PerformDecomposition(stage, signal, psiCoeffs, phiCoeffs);
-
-    std::vector<std::complex<double>> zeroedPsi(psiCoeffs.size(), { 0.0, 0.0 });
-    std::vector<std::complex<double>> tempP, tempQ, tempRecovery;
-    processor.PerformReconstruction(stage, zeroedPsi, phiCoeffs, tempP, tempQ, tempRecovery);
-    PComponent = tempP;
-}
-
-static void ProcessWaveletBasis(const std::string& outputDirectory,
+// Одна задача пула: базис type, все уровни 1..maxStages из одного каскадного прохода MRA.
+// Sample = double для Haar и Daubechies6, std::complex<double> - для Шеннона.
+// Возвращает задание записи всех уровней для фонового писателя; inputSignal, outputDirectory
+// и sweep должны жить до writer.Finish()
+template <typename Sample>
+static std::function<void()> ProcessWaveletBasis(const std::string& outputDirectory,
     SignalProcessing::WaveletProcessor::WaveletType type,
-    const std::vector<std::complex<double>>& inputSignal,
-    int maxStages)
+    const std::vector<Sample>& inputSignal,
+    int maxStages,
+    SignalProcessing::NpzArchive& sweep)
 {
     int N = (int)inputSignal.size();
-    SignalProcessing::WaveletProcessor processor(N, type);
-    std::string basisName = GetWaveletName(type);
+    SignalProcessing::BasicWaveletProcessor<Sample> processor(N, type);
+
+    // Уровни 1..maxStages и компоненты P_s, Q_s за один каскадный проход:
+    // уровень s не пересчитывает уровни ниже себя.
+    // Обнуление psi-коэффициентов уровня s оставляет P_s = approximations[s - 1]
+    typename SignalProcessing::BasicWaveletProcessor<Sample>::DecompositionPyramid pyramid;
+    typename SignalProcessing::BasicWaveletProcessor<Sample>::MultiresolutionComponents components;
+    processor.PerformMultiresolutionAnalysis(maxStages, inputSignal, pyramid, components);
 
+    std::vector<std::vector<Sample>> differences(maxStages, std::vector<Sample>(N));
     for (int level = 1; level <= maxStages; level++)
-    {
-        std::vector<std::complex<double>> psiCoeffs, phiCoeffs;
-        processor.PerformDecomposition(level, inputSignal, psiCoeffs, phiCoeffs);
+        for (int i = 0; i < N; i++)
+            differences[level - 1][i] = inputSignal[i] - components.approximations[level - 1][i];
 
-        SaveCoefficientsToCSV(outputDirectory + "/coeffs_before_" + basisName + "_stage" + std::to_string(level) + ".csv",
-            level, psiCoeffs, phiCoeffs);
+    return [&outputDirectory, &inputSignal, &sweep, type, maxStages,
+        psiLevels = std::move(pyramid.waveletCoeffs), phiLevels = std::move(pyramid.scalingCoeffs),
+        filteredLevels = std::move(components.approximations), differences = std::move(differences)]()
+    {
+        for (int level = 1; level <= maxStages; level++)
+        {
+            std::string key = GetWaveletName(type) + "_stage" + std::to_string(level);
+            std::string suffix = key + ".csv";
+            const std::vector<Sample>& psiCoeffs = psiLevels[level - 1];
+            const std::vector<Sample>& phiCoeffs = phiLevels[level - 1];
+            const std::vector<Sample>& filteredSignal = filteredLevels[level - 1];
+            const std::vector<Sample>& difference = differences[level - 1];
+
+            // Те же данные, что в CSV, в родном dtype: <f8 для Хаара и D6, <c16 для Шеннона.
+            // coeffs_after и pq_components восстанавливаются из них (нули вместо psi и Q)
+            sweep.Add(key + "_psi", psiCoeffs);
+            sweep.Add(key + "_phi", phiCoeffs);
+            sweep.Add(key + "_filtered", filteredSignal);
+            sweep.Add(key + "_difference", difference);
+
+            if (!WRITE_CSV_FILES)
+                continue;
+
+            SaveCoefficientsToCSV(outputDirectory + "/coeffs_before_" + suffix, level, psiCoeffs, phiCoeffs);
+
+            std::vector<Sample> zeroedPsi(psiCoeffs.size(), Sample(0.0));
+            SaveCoefficientsToCSV(outputDirectory + "/coeffs_after_" + suffix, level, zeroedPsi, phiCoeffs);
+
+            SaveFilterResultsToCSV(outputDirectory + "/filter_results_" + suffix, inputSignal, filteredSignal, difference);
+
+            // P_(level-1) и Q_(level-1) отфильтрованного сигнала: P_level лежит в V_level, вложенном
+            // в V_(level-1), поэтому проекция не меняет его, а Q_(level-1) = 0 - без повторного разложения
+            std::vector<Sample> previousQ(filteredSignal.size(), Sample(0.0));
+            SavePQComponentsToCSV(outputDirectory + "/pq_components_" + suffix, filteredSignal, previousQ);
+        }
+    };
+}
 
-        std::vector<std::complex<double>> zeroedPsi(psiCoeffs.size(), { 0.0, 0.0 });
-        SaveCoefficientsToCSV(outputDirectory + "/coeffs_after_" + basisName + "_stage" + std::to_string(level) + ".csv",
-            level, zeroedPsi, phiCoeffs);
+// Базисы независимы и разлагаются пулом, каждый - одним разложением на maxStages уровней.
+// Задания записи передаются фоновому потоку в порядке базисов по мере готовности, так что
+// запись идёт параллельно с вычислениями, а члены архива всегда следуют в порядке
+// (базис, уровень) и wavelet_sweep.npz воспроизводим побайтно. Архив sweep трогает только
+// поток писателя, поэтому обходится без блокировок. Ключи: signal и
+// <базис>_stage<s>_{psi, phi, filtered, difference}
+static void RunWaveletExperiments(const std::string& outputDirectory,
+    const std::vector<double>& signal,
+    const std::vector<std::complex<double>>& complexSignal,
+    int maxStages)
+{
+    using namespace SignalProcessing;
+    using WT = WaveletProcessor::WaveletType;
 
-        std::vector<std::complex<double>> PComp, QComp, filteredSignal;
-        processor.PerformReconstruction(level, zeroedPsi, phiCoeffs, PComp, QComp, filteredSignal);
+    // Архив объявлен раньше писателя: задания записи завершаются до его разрушения
+    NpzArchive sweep(outputDirectory + "/wavelet_sweep.npz");
+    sweep.Add("signal", signal);
 
-        std::vector<std::complex<double>> difference(N);
-        for (int i = 0; i < N; i++)
-            difference[i] = inputSignal[i] - filteredSignal[i];
+    BackgroundWriter writer;
 
-        SaveFilterResultsToCSV(outputDirectory + "/filter_results_" + basisName + "_stage" + std::to_string(level) + ".csv",
-            inputSignal, filteredSignal, difference);
+    // Тот же пул, что выполняет проходы БПФ внутри заданий
+    ThreadPool& pool = Parallel::SharedPool();
+    std::vector<std::future<std::function<void()>>> jobs;
+    for (WT type : { WT::Haar, WT::Shannon, WT::Daubechies6 })
+    {
+        if (type == WT::Shannon)
+            jobs.push_back(pool.Submit([&, type]() {
+                return ProcessWaveletBasis(outputDirectory, type, complexSignal, maxStages, sweep); }));
+        else
+            jobs.push_back(pool.Submit([&, type]() {
+                return ProcessWaveletBasis(outputDirectory, type, signal, maxStages, sweep); }));
+    }
 
-        std::vector<std::complex<double>> previousP(N), previousQ(N);
-        if (level == 1)
+    // Задания пула ссылаются на локальные данные: до выхода дожидаемся всех,
+    // первое исключение пробрасывается после этого
+    std::exception_ptr firstError;
+    for (auto& job : jobs)
+    {
+        try
         {
-            previousP = filteredSignal;
-            for (int i = 0; i < N; i++)
-                previousQ[i] = { 0.0, 0.0 };
+            std::function<void()> writeTask = job.get();
+            if (!firstError)
+                writer.Submit(std::move(writeTask));
         }
-        else
+        catch (...)
         {
-            ComputeOnlyPComponent(processor, level - 1, filteredSignal, previousP);
-            for (int i = 0; i < N; i++)
-                previousQ[i] = filteredSignal[i] - previousP[i];
+            if (!firstError)
+                firstError = std::current_exception();
         }
-
-        SavePQComponentsToCSV(outputDirectory + "/pq_components_" + basisName + "_stage" + std::to_string(level) + ".csv",
-            previousP, previousQ);
     }
+    writer.Finish();
+    if (firstError)
+        std::rethrow_exception(firstError);
+    sweep.Close();
 }
 
+#ifdef SIGNAL_PROCESSING_COUNT_ALLOCATIONS
+// Выделения памяти в прогонах run после прогрева. Ёмкости буферов, которыми обмениваются
+// вызывающий и арены, выравниваются за несколько прогонов, а потоки общего пула дорастают
+// свои арены, когда им впервые достаются куски нужного размера, поэтому прогрев идёт до
+// нескольких прогонов подряд без выделений. Затем к куче не должен обращаться ни один прогон
+template <typename Run>
+static bool ExpectNoSteadyStateAllocations(const std::string& name, Run run)
+{
+    using SignalProcessing::Diagnostics::AllocationCount;
+    const int MAX_WARMUP_RUNS = 100;
+    const int QUIET_WARMUP_RUNS = 5;
+    const int MEASURED_RUNS = 5;
 
-std::vector<std::complex<double>> generateSignal(size_t N, double A, double B, double w2)
+    for (int warmup = 0, quiet = 0; warmup < MAX_WARMUP_RUNS && quiet < QUIET_WARMUP_RUNS; warmup++)
+    {
+        long long before = AllocationCount();
+        run();
+        quiet = AllocationCount() == before ? quiet + 1 : 0;
+    }
+
+    long long before = AllocationCount();
+    for (int i = 0; i < MEASURED_RUNS; i++)
+        run();
+    long long allocations = AllocationCount() - before;
+
+    std::cout << "Выделений памяти в установившемся режиме (" << name << "): " << allocations << std::endl;
+    if (allocations != 0)
+        std::cout << "ОШИБКА: " << name << " обращается к куче после прогрева" << std::endl;
+    return allocations == 0;
+}
+
+// Проверка арены рабочих буферов для вейвлетов: повторные разложения, восстановления, MRA,
+// подавление шума, стационарное и двумерное преобразования на тех же размерах
+template <typename Sample>
+static bool CheckSteadyStateAllocations(SignalProcessing::WaveletProcessor::WaveletType type,
+    const std::vector<Sample>& inputSignal,
+    int maxStages)
 {
-    std::vector<std::complex<double>> signal(N, { 0.0, 0.0 });
+    using namespace SignalProcessing;
+    using Processor = BasicWaveletProcessor<Sample>;
 
-    // Лучше использовать современный ГСЧ вместо srand/rand
-    unsigned seed = std::chrono::steady_clock::now().time_since_epoch().count();
-    std::mt19937 gen(seed);
-    // Если нужна детерминированность — закомментировать строку выше и использовать фиксированный seed
+    bool passed = true;
+    int N = (int)inputSignal.size();
+    for (int modeIdx = 1; modeIdx <= 3; modeIdx++)
+    {
+        auto mode = (typename Processor::TransformMode)modeIdx;
+        if (mode == Processor::TransformMode::Lifting && type == Processor::WaveletType::Shannon)
+            continue;
 
-    const double quarter = N / 4.0;
-    const double three_quarters = 3.0 * N / 4.0;
+        Processor processor(N, type, mode);
+        typename Processor::DecompositionPyramid pyramid, stationaryPyramid;
+        typename Processor::MultiresolutionComponents components;
+        std::vector<Sample> psiCoeffs, phiCoeffs, lowpassPart, highpassPart, reconstructed, denoised, stationary;
 
-    for (size_t j = 0; j < N; ++j) {
-        if ((j >= quarter && j <= N / 2.0) || (j > three_quarters)) {
-            double valS = A + B * std::cos(2.0 * PI * w2 * j / N);
-            signal[j] = { valS, 0.0 };
-        }
-        else {
-            signal[j] = { 0.0, 0.0 };
-        }
+        // Изображение N x N из сдвигов сигнала; ёмкость задаётся один раз, дальше только перезапись
+        std::vector<Sample> image((size_t)N * N);
+
+        passed &= ExpectNoSteadyStateAllocations(GetWaveletName(type) + ", режим " + std::to_string(modeIdx), [&]()
+        {
+            processor.PerformMultiresolutionAnalysis(maxStages, inputSignal, pyramid, components);
+            for (int level = 1; level <= maxStages; level++)
+            {
+                processor.PerformDecomposition(level, inputSignal, psiCoeffs, phiCoeffs);
+                processor.PerformReconstruction(level, psiCoeffs, phiCoeffs, lowpassPart, highpassPart, reconstructed);
+            }
+            denoised.assign(inputSignal.begin(), inputSignal.end());
+            processor.PerformDenoising(maxStages, denoised,
+                Processor::ThresholdRule::Soft, Processor::ThresholdSelection::SURE);
+
+            processor.PerformStationaryDecomposition(maxStages, inputSignal, stationaryPyramid);
+            processor.PerformStationaryReconstruction(maxStages, stationaryPyramid, stationary);
+
+            for (int row = 0; row < N; row++)
+                for (int col = 0; col < N; col++)
+                    image[(size_t)row * N + col] = inputSignal[(row + col) % N];
+            processor.PerformDecomposition2D(maxStages, image);
+            processor.PerformReconstruction2D(maxStages, image);
+        });
     }
+    return passed;
+}
 
-        return signal;
+// Проверка арены для БПФ и свёрток: двумерное БПФ (степень двойки и произвольный размер),
+// ConvolutionEngine всеми способами и циклическая свёртка SignalTransformer
+static bool CheckTransformAllocations(const std::vector<std::complex<double>>& inputSignal)
+{
+    using namespace SignalProcessing;
+    using Complex = std::complex<double>;
+
+    bool passed = true;
+    for (int size : { 64, 60 })
+    {
+        std::vector<Complex> matrix((size_t)size * size);
+        passed &= ExpectNoSteadyStateAllocations("FourierCore::Transform2D " + std::to_string(size) + "x" + std::to_string(size), [&]()
+        {
+            for (size_t i = 0; i < matrix.size(); i++)
+                matrix[i] = inputSignal[i % inputSignal.size()];
+            FourierCore::Transform2D(matrix, size, size, false);
+            FourierCore::Transform2D(matrix, size, size, true);
+        });
+    }
+
+    std::vector<Complex> taps(33);
+    for (size_t k = 0; k < taps.size(); k++)
+        taps[k] = Complex(1.0 / (k + 1), 0.5 / (k + 2));
+
+    const struct { ConvolutionEngine::Method method; const char* name; } methods[] = {
+        { ConvolutionEngine::Method::Direct, "Direct" },
+        { ConvolutionEngine::Method::OverlapSave, "OverlapSave" },
+        { ConvolutionEngine::Method::OverlapAdd, "OverlapAdd" } };
+    for (const auto& entry : methods)
+    {
+        ConvolutionEngine engine(taps, entry.method);
+        std::vector<Complex> convolved;
+        passed &= ExpectNoSteadyStateAllocations(std::string("ConvolutionEngine::Convolve, ") + entry.name,
+            [&]() { engine.Convolve(inputSignal, convolved); });
     }
 
+    SignalTransformer transformer;
+    std::vector<Complex> kernel(inputSignal.size()), circular;
+    std::copy(taps.begin(), taps.end(), kernel.begin());
+    passed &= ExpectNoSteadyStateAllocations("SignalTransformer::ComputeConvolution",
+        [&]() { transformer.ComputeConvolution(inputSignal, kernel, circular); });
+
+    return passed;
+}
+#endif
+
+// z(j) = A + B cos(2 pi w2 j / N) при N/4 <= j <= N/2 и j > 3N/4, иначе 0
+std::vector<double> generateSignal(size_t N, double A, double B, double w2)
+{
+    using SignalProcessing::SignalSynthesizer;
+    SignalSynthesizer::Gate gate = {
+        { (long long)std::ceil(N / 4.0), (long long)std::floor(N / 2.0) + 1 },
+        { (long long)std::floor(3.0 * N / 4.0) + 1, (long long)N } };
+
+    SignalSynthesizer synthesizer;
+    synthesizer.AddConstant(A, gate).AddTone(B, w2, 0.0, gate);
+
+    std::vector<double> signal;
+    synthesizer.Generate(N, signal);
+    return signal;
+}
+
 int main() {
     system("chcp 65001 > nul"); // Устанавливаем UTF-8 в консоли Windows
 
@@ -177,44 +377,50 @@ int main() {
 
 
     // Генерация вариант 1:
-    // std::vector<std::complex<double>> signal = generateSignal(N, A, B, w2);
+    // std::vector<double> signal = generateSignal(N, A, B, w2);
 
     // Генерация вариант 2:
     
-    std::mt19937 randomGenerator(42);
+    // z(j) = A cos(2π ω₁ j / N + φ) + B cos(2π ω₂ j / N) + шум U(-0.05, 0.05);
+    // шум Philox с ключом 42 воспроизводим при любом числе потоков
     const double phi = 0.0; // добавить фазу
-    std::vector<std::complex<double>> signal(N, { 0.0, 0.0 });
-    std::uniform_real_distribution<double> noiseDistribution(-0.05, 0.05);
-
-    for (int j = 0; j < N; j++)
-    {
-        // z(j) = A cos(2π ω₁ j / N + φ) + B cos(2π ω₂ j / N)
-        double cleanSignal = A * std::cos(Constants::TWO_PI * w1 * j / N + phi)
-            + B * std::cos(Constants::TWO_PI * w2 * j / N);
+    SignalSynthesizer synthesizer(42);
+    synthesizer.AddTone(A, w1, phi).AddTone(B, w2).AddUniformNoise(-0.05, 0.05);
 
-        double noise = noiseDistribution(randomGenerator);
-        signal[j] = { cleanSignal + noise, 0.0 };
-    }
+    std::vector<double> signal;
+    synthesizer.Generate(N, signal);
     
 
 
-    SaveSignalToCSV(outputDirectory + "/generated_signal.csv", signal);
+    // Обработка для всех трех базисов; фильтр Шеннона комплексный:
+    // только для него сигнал переводится в комплексный
+    std::vector<std::complex<double>> complexSignal(signal.begin(), signal.end());
 
-    // Обработка для всех трех базисов
-    ProcessWaveletBasis(outputDirectory,
-        WaveletProcessor::WaveletType::Haar,
-        signal, maxStages);
-
-    ProcessWaveletBasis(outputDirectory,
-        WaveletProcessor::WaveletType::Shannon,
-        signal, maxStages);
-
-    ProcessWaveletBasis(outputDirectory,
-        WaveletProcessor::WaveletType::Daubechies6,
-        signal, maxStages);
+    // Ошибки вывода (нет каталога, не открылся архив) и вычислений сообщаются, а не обрывают
+    // программу через std::terminate
+    try
+    {
+        SaveSignalToCSV(outputDirectory + "/generated_signal.csv", signal);
+        RunWaveletExperiments(outputDirectory, signal, complexSignal, maxStages);
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << "Ошибка: " << error.what() << std::endl;
+        return 1;
+    }
 
     std::cout << "Файлы сохранены в: " << outputDirectory << std::endl;
 
+#ifdef SIGNAL_PROCESSING_COUNT_ALLOCATIONS
+    bool allocationFree = CheckSteadyStateAllocations(WaveletProcessor::WaveletType::Haar, signal, maxStages);
+    allocationFree &= CheckSteadyStateAllocations(WaveletProcessor::WaveletType::Shannon, complexSignal, maxStages);
+    allocationFree &= CheckSteadyStateAllocations(WaveletProcessor::WaveletType::Daubechies6, signal, maxStages);
+    allocationFree &= CheckTransformAllocations(complexSignal);
+    if (!allocationFree)
+        return 1;
+#endif
+
     return 0;
 
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,81 @@
+"""Чтение wavelet_sweep.npz - все результаты CM_7 одним двоичным файлом вместо десятков CSV.
+
+Ключи архива: signal и {basis}_stage{s}_psi / _phi / _filtered / _difference
+(complex128 для Шеннона, float64 для Хаара и D6). Функции собирают DataFrame
+с теми же столбцами, что и соответствующие CSV, поэтому код графиков не меняется.
+Если архива нет, возвращается None и скрипты читают CSV, как раньше.
+"""
+import os
+import numpy as np
+import pandas as pd
+
+SWEEP_FILE = "wavelet_sweep.npz"
+
+_sweeps = {}
+
+
+def load_sweep(base_dir: str):
+    """Архив открывается один раз на каталог; массивы читаются по мере обращения"""
+    path = os.path.join(base_dir, SWEEP_FILE)
+    if path not in _sweeps:
+        _sweeps[path] = np.load(path) if os.path.exists(path) else None
+    return _sweeps[path]
+
+
+def _arrays(base_dir: str, basis: str, stage: int, *fields):
+    sweep = load_sweep(base_dir)
+    if sweep is None:
+        return None
+    keys = [f"{basis}_stage{stage}_{field}" for field in fields]
+    if any(key not in sweep.files for key in keys):
+        return None
+    return [sweep[key] for key in keys]
+
+
+def coeffs_frame(base_dir: str, basis: str, stage: int, zeroed: bool = False):
+    """Аналог coeffs_before_* (zeroed=False) и coeffs_after_* (zeroed=True)"""
+    arrays = _arrays(base_dir, basis, stage, "psi", "phi")
+    if arrays is None:
+        return None
+    psi, phi = arrays
+    if zeroed:
+        psi = np.zeros_like(psi)
+    k = np.arange(len(psi))
+    return pd.DataFrame({
+        "k": k,
+        "index": k << stage,
+        "psi_real": np.real(psi),
+        "psi_imag": np.imag(psi),
+        "phi_real": np.real(phi),
+        "phi_imag": np.imag(phi),
+        "psi_magnitude": np.abs(psi),
+        "phi_magnitude": np.abs(phi),
+    })
+
+
+def filter_results_frame(base_dir: str, basis: str, stage: int):
+    """Аналог filter_results_*"""
+    arrays = _arrays(base_dir, basis, stage, "filtered", "difference")
+    if arrays is None:
+        return None
+    filtered, difference = arrays
+    signal = load_sweep(base_dir)["signal"]
+    return pd.DataFrame({
+        "index": np.arange(len(signal)),
+        "original_real": np.real(signal),
+        "filtered_real": np.real(filtered),
+        "difference_real": np.real(difference),
+    })
+
+
+def pq_components_frame(base_dir: str, basis: str, stage: int):
+    """Аналог pq_components_*: P_(s-1) отфильтрованного сигнала совпадает с ним, Q_(s-1) = 0"""
+    arrays = _arrays(base_dir, basis, stage, "filtered")
+    if arrays is None:
+        return None
+    filtered = np.real(arrays[0])
+    return pd.DataFrame({
+        "index": np.arange(len(filtered)),
+        "P_real": filtered,
+        "Q_real": np.zeros_like(filtered),
+    })
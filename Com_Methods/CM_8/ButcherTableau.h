@@ -0,0 +1,146 @@
+#pragma once
+#ifndef BUTCHER_TABLEAU_H
+#define BUTCHER_TABLEAU_H
+
+namespace Ode
+{
+    // Явные методы Рунге - Кутты задаются таблицами Бутчера на этапе компиляции:
+    //   k_s = f(t + C[s] h, y + h sum_{j<s} A[s][j] k_j),  y(t + h) = y + h sum_s B[s] k_s.
+    // Коэффициенты - constexpr, поэтому стадии разворачиваются, а нулевые A[s][j] и B[s]
+    // исключаются из вычислений при компиляции (см. ExplicitRungeKutta)
+
+    // Явный метод Эйлера, порядок 1
+    struct ExplicitEuler
+    {
+        static constexpr int Stages = 1;
+        static constexpr int Order = 1;
+        static constexpr double A[Stages][Stages] = { { 0.0 } };
+        static constexpr double B[Stages] = { 1.0 };
+        static constexpr double C[Stages] = { 0.0 };
+    };
+
+    // Метод средней точки, порядок 2
+    struct Midpoint
+    {
+        static constexpr int Stages = 2;
+        static constexpr int Order = 2;
+        static constexpr double A[Stages][Stages] = {
+            { 0.0, 0.0 },
+            { 0.5, 0.0 } };
+        static constexpr double B[Stages] = { 0.0, 1.0 };
+        static constexpr double C[Stages] = { 0.0, 0.5 };
+    };
+
+    // Метод Хойна (трапеций), порядок 2
+    struct Heun
+    {
+        static constexpr int Stages = 2;
+        static constexpr int Order = 2;
+        static constexpr double A[Stages][Stages] = {
+            { 0.0, 0.0 },
+            { 1.0, 0.0 } };
+        static constexpr double B[Stages] = { 0.5, 0.5 };
+        static constexpr double C[Stages] = { 0.0, 1.0 };
+    };
+
+    // Метод Кутты третьего порядка
+    struct Kutta3
+    {
+        static constexpr int Stages = 3;
+        static constexpr int Order = 3;
+        static constexpr double A[Stages][Stages] = {
+            { 0.0, 0.0, 0.0 },
+            { 0.5, 0.0, 0.0 },
+            { -1.0, 2.0, 0.0 } };
+        static constexpr double B[Stages] = { 1.0 / 6.0, 2.0 / 3.0, 1.0 / 6.0 };
+        static constexpr double C[Stages] = { 0.0, 0.5, 1.0 };
+    };
+
+    // Классический метод Рунге - Кутты четвёртого порядка
+    struct ClassicRK4
+    {
+        static constexpr int Stages = 4;
+        static constexpr int Order = 4;
+        static constexpr double A[Stages][Stages] = {
+            { 0.0, 0.0, 0.0, 0.0 },
+            { 0.5, 0.0, 0.0, 0.0 },
+            { 0.0, 0.5, 0.0, 0.0 },
+            { 0.0, 0.0, 1.0, 0.0 } };
+        static constexpr double B[Stages] = { 1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0 };
+        static constexpr double C[Stages] = { 0.0, 0.5, 0.5, 1.0 };
+    };
+
+    // Правило 3/8, порядок 4
+    struct ThreeEighthsRK4
+    {
+        static constexpr int Stages = 4;
+        static constexpr int Order = 4;
+        static constexpr double A[Stages][Stages] = {
+            { 0.0, 0.0, 0.0, 0.0 },
+            { 1.0 / 3.0, 0.0, 0.0, 0.0 },
+            { -1.0 / 3.0, 1.0, 0.0, 0.0 },
+            { 1.0, -1.0, 1.0, 0.0 } };
+        static constexpr double B[Stages] = { 1.0 / 8.0, 3.0 / 8.0, 3.0 / 8.0, 1.0 / 8.0 };
+        static constexpr double C[Stages] = { 0.0, 1.0 / 3.0, 2.0 / 3.0, 1.0 };
+    };
+
+    // Вложенная пара Дорманда - Принса 5(4) (Hairer, Norsett, Wanner, DOPRI5).
+    // Решение - 5-го порядка, E = B - B^ оценивает ошибку по вложенному решению 4-го порядка.
+    // Седьмая стадия берётся в новой точке (A[6] = B, C[6] = 1) и служит первой стадией
+    // следующего шага (FSAL). D - коэффициенты непрерывного продолжения 4-го порядка
+    struct DormandPrince5
+    {
+        static constexpr int Stages = 7;
+        static constexpr int Order = 5;
+        static constexpr int EmbeddedOrder = 4;
+        static constexpr bool FirstSameAsLast = true;
+        static constexpr double A[Stages][Stages] = {
+            { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+            { 1.0 / 5.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+            { 3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+            { 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0, 0.0, 0.0 },
+            { 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0.0, 0.0, 0.0 },
+            { 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0, 0.0, 0.0 },
+            { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0, 0.0 } };
+        static constexpr double B[Stages] = {
+            35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0, 0.0 };
+        static constexpr double C[Stages] = { 0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0 };
+        static constexpr double E[Stages] = {
+            71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0 };
+        static constexpr double D[Stages] = {
+            -12715105075.0 / 11282082432.0, 0.0, 87487479700.0 / 32700410799.0, -10690763975.0 / 1880347072.0,
+            701980252875.0 / 199316789632.0, -1453857185.0 / 822651844.0, 69997945.0 / 29380423.0 };
+    };
+
+    // Проверки таблицы при компиляции: метод явный (A строго нижнетреугольная),
+    // C[s] = sum_j A[s][j] и sum_s B[s] = 1 (порядок не ниже первого)
+    template <typename Tableau>
+    constexpr bool IsExplicitTableau()
+    {
+        for (int s = 0; s < Tableau::Stages; s++)
+            for (int j = s; j < Tableau::Stages; j++)
+                if (Tableau::A[s][j] != 0.0)
+                    return false;
+        return true;
+    }
+
+    template <typename Tableau>
+    constexpr bool IsConsistentTableau()
+    {
+        const double tolerance = 1e-14;
+        double weightSum = 0.0;
+        for (int s = 0; s < Tableau::Stages; s++)
+        {
+            double rowSum = 0.0;
+            for (int j = 0; j < s; j++)
+                rowSum += Tableau::A[s][j];
+            double rowError = rowSum - Tableau::C[s];
+            if (rowError > tolerance || rowError < -tolerance)
+                return false;
+            weightSum += Tableau::B[s];
+        }
+        return weightSum - 1.0 <= tolerance && 1.0 - weightSum <= tolerance;
+    }
+}
+
+#endif
@@ -0,0 +1,222 @@
+#pragma once
+#ifndef ENSEMBLE_SOLVER_H
+#define ENSEMBLE_SOLVER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "OdeSolvers.h"
+#include "LotkaVolterra.h"
+#include "../CM_7/ParallelFor.h"
+
+namespace Ode
+{
+    // Ансамбль систем Лотки - Вольтерры в формате SoA: параметры и начальные состояния
+    // членов ансамбля задаются во время выполнения, по массиву на величину
+    struct LotkaVolterraEnsemble
+    {
+        std::vector<double> alpha, beta, gamma, delta;
+        std::vector<double> prey, predator;
+
+        size_t Size() const { return prey.size(); }
+
+        void Add(const LotkaVolterra& model, double x0, double y0)
+        {
+            alpha.push_back(model.alpha);
+            beta.push_back(model.beta);
+            gamma.push_back(model.gamma);
+            delta.push_back(model.delta);
+            prey.push_back(x0);
+            predator.push_back(y0);
+        }
+    };
+
+    struct EnsembleOptions
+    {
+        double step = 0.01;
+        int steps = 0;
+        int decimation = 0;  // траектории - каждый decimation-й шаг; 0 - только статистика
+        int threads = 0;     // 0 - по числу ядер; на результат не влияет
+    };
+
+    // Итоги по каждому члену ансамбля (индексация как в LotkaVolterraEnsemble)
+    struct EnsembleResult
+    {
+        std::vector<double> finalPrey, finalPredator;
+        std::vector<double> minPrey, maxPrey, minPredator, maxPredator;
+
+        // Средние по времени (правило прямоугольников по узлам сетки); на замкнутой орбите
+        // за целое число периодов они равны равновесию gamma / delta, alpha / beta
+        std::vector<double> meanPrey, meanPredator;
+
+        // |V(T) - V(0)| / max(|V(0)|, 1) для первого интеграла V (LotkaVolterra::Invariant), см. InvariantDeviation
+        std::vector<double> invariantDrift;
+
+        // Прореженные траектории: отсчёт k члена m - [m * samples + k], samples = steps / decimation + 1
+        int samples = 0;
+        std::vector<double> preyTrajectories, predatorTrajectories;
+    };
+
+    namespace Detail
+    {
+        // Правая часть Лотки - Вольтерры для блока из lanes членов ансамбля.
+        // Состояние блока - один вектор [x_0..x_(L-1), y_0..y_(L-1)]: стадии Рунге - Кутты
+        // идут одним плоским циклом по всем компонентам всех членов, а цикл по членам здесь
+        // не имеет зависимостей - оба векторизуются. __restrict (GCC, Clang, MSVC) снимает проверки
+        // пересечения шести массивов, без которых компилятор отказывается векторизовать цикл
+        struct LotkaVolterraBlock
+        {
+            const double* alpha;
+            const double* beta;
+            const double* gamma;
+            const double* delta;
+            size_t lanes;
+
+            void operator()(double, const std::vector<double>& y, std::vector<double>& dydt) const
+            {
+                const double* __restrict x = y.data();
+                const double* __restrict p = y.data() + lanes;
+                double* __restrict dx = dydt.data();
+                double* __restrict dp = dydt.data() + lanes;
+                const double* __restrict a = alpha;
+                const double* __restrict b = beta;
+                const double* __restrict c = gamma;
+                const double* __restrict d = delta;
+                for (size_t l = 0; l < lanes; l++)
+                {
+                    dx[l] = (a[l] - b[l] * p[l]) * x[l];
+                    dp[l] = (-c[l] + d[l] * x[l]) * p[l];
+                }
+            }
+        };
+    }
+
+    // Интегрирование ансамбля явным методом Tableau с постоянным шагом: члены ансамбля идут
+    // блоками по BLOCK_LANES синхронно (общее t и h), блоки распределяются между потоками.
+    // Каждый член считается одними и теми же операциями независимо от разбиения,
+    // поэтому результат не зависит от числа потоков
+    template <typename Tableau = ClassicRK4>
+    class EnsembleSolver
+    {
+    public:
+        // 2 компоненты x 256 членов: состояние, стадия и наклоны RK4 занимают ~25 КБ и остаются в L1/L2
+        static constexpr size_t BLOCK_LANES = 256;
+
+        static void Run(const LotkaVolterraEnsemble& ensemble, const EnsembleOptions& options, EnsembleResult& result)
+        {
+            size_t members = ensemble.Size();
+            if (ensemble.alpha.size() != members || ensemble.beta.size() != members ||
+                ensemble.gamma.size() != members || ensemble.delta.size() != members ||
+                ensemble.predator.size() != members)
+                throw std::runtime_error("Массивы параметров и состояний ансамбля разной длины");
+            if (options.steps < 0 || options.decimation < 0)
+                throw std::runtime_error("Число шагов и прореживание не могут быть отрицательными");
+
+            for (std::vector<double>* column : { &result.finalPrey, &result.finalPredator, &result.minPrey,
+                &result.maxPrey, &result.minPredator, &result.maxPredator, &result.meanPrey,
+                &result.meanPredator, &result.invariantDrift })
+                column->resize(members);
+
+            result.samples = options.decimation > 0 ? options.steps / options.decimation + 1 : 0;
+            result.preyTrajectories.resize(members * result.samples);
+            result.predatorTrajectories.resize(members * result.samples);
+
+            int blocks = (int)((members + BLOCK_LANES - 1) / BLOCK_LANES);
+            SignalProcessing::Parallel::ForRange(0, blocks, [&](int firstBlock, int lastBlock)
+            {
+                for (int block = firstBlock; block < lastBlock; block++)
+                {
+                    size_t first = block * BLOCK_LANES;
+                    RunBlock(ensemble, options, first, std::min(BLOCK_LANES, members - first), result);
+                }
+            }, 1, options.threads);
+        }
+
+    private:
+        static void RunBlock(const LotkaVolterraEnsemble& ensemble, const EnsembleOptions& options,
+            size_t first, size_t lanes, EnsembleResult& result)
+        {
+            Detail::LotkaVolterraBlock system = { ensemble.alpha.data() + first, ensemble.beta.data() + first,
+                ensemble.gamma.data() + first, ensemble.delta.data() + first, lanes };
+
+            std::vector<double> state(2 * lanes);
+            std::copy_n(ensemble.prey.data() + first, lanes, state.data());
+            std::copy_n(ensemble.predator.data() + first, lanes, state.data() + lanes);
+
+            double* minPrey = result.minPrey.data() + first;
+            double* maxPrey = result.maxPrey.data() + first;
+            double* minPredator = result.minPredator.data() + first;
+            double* maxPredator = result.maxPredator.data() + first;
+            double* sumPrey = result.meanPrey.data() + first;
+            double* sumPredator = result.meanPredator.data() + first;
+            const double* x = state.data();
+            const double* p = state.data() + lanes;
+
+            for (size_t l = 0; l < lanes; l++)
+            {
+                minPrey[l] = maxPrey[l] = x[l];
+                minPredator[l] = maxPredator[l] = p[l];
+                sumPrey[l] = sumPredator[l] = 0.0;
+            }
+
+            ExplicitRungeKutta<Tableau, std::vector<double>> stepper(state);
+            Integrate(stepper, system, 0.0, state, options.step, options.steps,
+                [&](int step, double, const std::vector<double>&)
+            {
+                // Сумма по узлам 0..steps-1: среднее по полуинтервалу [0, T)
+                if (step < options.steps)
+                {
+                    for (size_t l = 0; l < lanes; l++)
+                    {
+                        sumPrey[l] += x[l];
+                        sumPredator[l] += p[l];
+                    }
+                }
+                for (size_t l = 0; l < lanes; l++)
+                {
+                    minPrey[l] = std::min(minPrey[l], x[l]);
+                    maxPrey[l] = std::max(maxPrey[l], x[l]);
+                    minPredator[l] = std::min(minPredator[l], p[l]);
+                    maxPredator[l] = std::max(maxPredator[l], p[l]);
+                }
+
+                if (options.decimation > 0 && step % options.decimation == 0)
+                {
+                    int sample = step / options.decimation;
+                    for (size_t l = 0; l < lanes; l++)
+                    {
+                        result.preyTrajectories[(first + l) * result.samples + sample] = x[l];
+                        result.predatorTrajectories[(first + l) * result.samples + sample] = p[l];
+                    }
+                }
+            });
+
+            for (size_t l = 0; l < lanes; l++)
+            {
+                size_t m = first + l;
+                if (options.steps > 0)
+                {
+                    sumPrey[l] /= options.steps;
+                    sumPredator[l] /= options.steps;
+                }
+                else
+                {
+                    sumPrey[l] = x[l];
+                    sumPredator[l] = p[l];
+                }
+                result.finalPrey[m] = x[l];
+                result.finalPredator[m] = p[l];
+
+                double initial = LotkaVolterra::Invariant(ensemble.alpha[m], ensemble.beta[m],
+                    ensemble.gamma[m], ensemble.delta[m], ensemble.prey[m], ensemble.predator[m]);
+                double current = LotkaVolterra::Invariant(ensemble.alpha[m], ensemble.beta[m],
+                    ensemble.gamma[m], ensemble.delta[m], x[l], p[l]);
+                result.invariantDrift[m] = InvariantDeviation(current, initial);
+            }
+        }
+    };
+}
+
+#endif
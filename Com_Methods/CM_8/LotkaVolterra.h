@@ -0,0 +1,43 @@
+#pragma once
+#ifndef LOTKA_VOLTERRA_H
+#define LOTKA_VOLTERRA_H
+
+#include <array>
+#include <cmath>
+
+namespace Ode
+{
+    // Модель Лотки - Вольтерры: x - жертвы, y - хищники
+    //   x' = (alpha - beta y) x,  y' = (-gamma + delta x) y
+    struct LotkaVolterra
+    {
+        using State = std::array<double, 2>;
+
+        double alpha;
+        double beta;
+        double gamma;
+        double delta;
+
+        double PreyEquilibrium() const { return gamma / delta; }
+        double PredatorEquilibrium() const { return alpha / beta; }
+
+        // Первый интеграл V = delta x - gamma ln x + beta y - alpha ln y: постоянен на траектории
+        static double Invariant(double alpha, double beta, double gamma, double delta, double x, double y)
+        {
+            return delta * x - gamma * std::log(x) + beta * y - alpha * std::log(y);
+        }
+
+        double Invariant(const State& y) const
+        {
+            return Invariant(alpha, beta, gamma, delta, y[0], y[1]);
+        }
+
+        void operator()(double, const State& y, State& dydt) const
+        {
+            dydt[0] = (alpha - beta * y[1]) * y[0];
+            dydt[1] = (-gamma + delta * y[0]) * y[1];
+        }
+    };
+}
+
+#endif
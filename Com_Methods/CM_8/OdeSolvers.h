@@ -0,0 +1,629 @@
+#pragma once
+#ifndef ODE_SOLVERS_H
+#define ODE_SOLVERS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include "ButcherTableau.h"
+
+namespace Ode
+{
+    // Решатели задачи Коши y' = f(t, y).
+    // State - массив значений с size() и operator[]: std::array<double, N> (размер известен при
+    // компиляции, циклы по компонентам разворачиваются) или std::vector<double> / SoA-буфер.
+    // System - функтор system(t, y, dydt), записывающий производную в dydt.
+    // Шаговые методы имеют общий интерфейс Step(system, t, h, y): y(t) -> y(t + h)
+
+    namespace Detail
+    {
+        // Стадии явного метода Рунге - Кутты по таблице Tableau и комбинации наклонов
+        // с constexpr-весами таблицы; общая часть одношаговых решателей
+        template <typename Tableau, typename State>
+        class RungeKuttaStages
+        {
+            static_assert(IsExplicitTableau<Tableau>(), "Таблица Бутчера должна задавать явный метод");
+            static_assert(IsConsistentTableau<Tableau>(), "Таблица Бутчера несогласована: C != sum A или sum B != 1");
+
+        protected:
+            using StageSequence = std::make_integer_sequence<int, Tableau::Stages>;
+            using Weights = double[Tableau::Stages];
+
+            std::array<State, Tableau::Stages> slopes;
+            State stageState;
+
+            explicit RungeKuttaStages(const State& shape)
+                : stageState(shape)
+            {
+                slopes.fill(shape);
+            }
+
+            // Наклоны k_First..k_(S-1); при First = 1 k_0 уже лежит в slopes[0] (FSAL)
+            template <int First, typename System>
+            void ComputeStages(const System& system, double t, double h, const State& y)
+            {
+                ComputeStages<First>(system, t, h, y, StageSequence());
+            }
+
+            // sum_j weights[j] k_j[i] по всем стадиям
+            double Combination(const Weights& weights, size_t i) const
+            {
+                return WeightedSum(weights, i, StageSequence());
+            }
+
+        private:
+            template <int First, typename System, int... Stage>
+            void ComputeStages(const System& system, double t, double h, const State& y,
+                std::integer_sequence<int, Stage...>)
+            {
+                (ComputeStage<First, Stage>(system, t, h, y), ...);
+            }
+
+            template <int First, int Stage, typename System>
+            void ComputeStage(const System& system, double t, double h, const State& y)
+            {
+                if constexpr (Stage < First)
+                    return;
+                else if constexpr (Stage == 0)
+                    system(t, y, slopes[0]);
+                else
+                {
+                    for (size_t i = 0; i < y.size(); i++)
+                        stageState[i] = y[i] + h * WeightedSum(Tableau::A[Stage], i, std::make_integer_sequence<int, Stage>());
+                    system(t + Tableau::C[Stage] * h, stageState, slopes[Stage]);
+                }
+            }
+
+            template <int... J>
+            double WeightedSum(const Weights& weights, size_t i, std::integer_sequence<int, J...>) const
+            {
+                // -0.0 - нейтральный элемент сложения, компилятор убирает его без -ffast-math
+                double sum = -0.0;
+                (AddWeighted(sum, weights[J], slopes[J][i]), ...);
+                return sum;
+            }
+
+            // Веса - константы таблицы: после подстановки слагаемые с нулевым весом не генерируются
+            static void AddWeighted(double& sum, double weight, double slope)
+            {
+                if (weight != 0.0)
+                    sum += weight * slope;
+            }
+        };
+    }
+
+    // Явный метод Рунге - Кутты по таблице Бутчера Tableau
+    template <typename Tableau, typename State>
+    class ExplicitRungeKutta : private Detail::RungeKuttaStages<Tableau, State>
+    {
+        using Base = Detail::RungeKuttaStages<Tableau, State>;
+
+    public:
+        static constexpr int Stages = Tableau::Stages;
+        static constexpr int Order = Tableau::Order;
+
+        // shape задаёт размер рабочих состояний (нужен для std::vector)
+        explicit ExplicitRungeKutta(const State& shape = State())
+            : Base(shape)
+        {
+        }
+
+        template <typename System>
+        void Step(const System& system, double t, double h, State& y)
+        {
+            Base::template ComputeStages<0>(system, t, h, y);
+            for (size_t i = 0; i < y.size(); i++)
+                y[i] += h * Base::Combination(Tableau::B, i);
+        }
+
+        // Наклоны последнего шага (k_s)
+        const State& GetSlope(int stage) const { return Base::slopes[stage]; }
+    };
+
+    template <typename State>
+    using RungeKutta4 = ExplicitRungeKutta<ClassicRK4, State>;
+
+    namespace Detail
+    {
+        // Коэффициенты методов Адамса порядка Order:
+        //   Башфорт  y_(n+1) = y_n + h sum_j Bashforth[j] f_(n-j),  j = 0..Order-1;
+        //   Моултон  y_(n+1) = y_n + h (Moulton[0] f_(n+1) + sum_(j>0) Moulton[j] f_(n+1-j))
+        template <int Order>
+        struct AdamsCoefficients;
+
+        template <>
+        struct AdamsCoefficients<1>
+        {
+            static constexpr double Bashforth[1] = { 1.0 };
+            static constexpr double Moulton[1] = { 1.0 };
+        };
+
+        template <>
+        struct AdamsCoefficients<2>
+        {
+            static constexpr double Bashforth[2] = { 3.0 / 2.0, -1.0 / 2.0 };
+            static constexpr double Moulton[2] = { 1.0 / 2.0, 1.0 / 2.0 };
+        };
+
+        template <>
+        struct AdamsCoefficients<3>
+        {
+            static constexpr double Bashforth[3] = { 23.0 / 12.0, -16.0 / 12.0, 5.0 / 12.0 };
+            static constexpr double Moulton[3] = { 5.0 / 12.0, 8.0 / 12.0, -1.0 / 12.0 };
+        };
+
+        template <>
+        struct AdamsCoefficients<4>
+        {
+            static constexpr double Bashforth[4] = { 55.0 / 24.0, -59.0 / 24.0, 37.0 / 24.0, -9.0 / 24.0 };
+            static constexpr double Moulton[4] = { 9.0 / 24.0, 19.0 / 24.0, -5.0 / 24.0, 1.0 / 24.0 };
+        };
+
+        template <>
+        struct AdamsCoefficients<5>
+        {
+            static constexpr double Bashforth[5] = {
+                1901.0 / 720.0, -2774.0 / 720.0, 2616.0 / 720.0, -1274.0 / 720.0, 251.0 / 720.0 };
+            static constexpr double Moulton[5] = {
+                251.0 / 720.0, 646.0 / 720.0, -264.0 / 720.0, 106.0 / 720.0, -19.0 / 720.0 };
+        };
+
+        // Сумма весов метода Адамса равна 1 (точность на y' = const)
+        template <int Order>
+        constexpr bool IsConsistentAdams(const double (&weights)[Order])
+        {
+            double sum = 0.0;
+            for (int j = 0; j < Order; j++)
+                sum += weights[j];
+            return sum - 1.0 <= 1e-14 && 1.0 - sum <= 1e-14;
+        }
+    }
+
+    // Режимы многошагового метода Адамса:
+    //   Bashforth - явный Адамс - Башфорт, 1 вычисление f на шаг;
+    //   PEC  - прогноз Башфортом, коррекция Моултоном, в историю идёт f в точке прогноза (1 вычисление);
+    //   PECE - то же, но f пересчитывается в исправленной точке (2 вычисления, меньше ошибка)
+    enum class AdamsMode
+    {
+        Bashforth,
+        PEC,
+        PECE
+    };
+
+    // Метод Адамса порядка Order (1..5) с постоянным шагом. Прошлые производные f_n..f_(n-Order+1)
+    // хранятся в кольцевом буфере из Order состояний: память не зависит от числа шагов, и каждая
+    // производная вычисляется один раз. Первые Order - 1 шагов делает RK4 (его k_1 = f_n
+    // идёт в историю); локальная ошибка разгона O(h^5) не портит порядок до 5-го включительно.
+    // Шаг h постоянный, при смене h или начальной точки нужен Reset
+    template <int MethodOrder, AdamsMode Mode, typename State>
+    class AdamsMultistep
+    {
+        static_assert(MethodOrder >= 1 && MethodOrder <= 5, "Реализованы методы Адамса порядков 1 - 5");
+
+        using Coefficients = Detail::AdamsCoefficients<MethodOrder>;
+        static_assert(Detail::IsConsistentAdams(Coefficients::Bashforth) &&
+            Detail::IsConsistentAdams(Coefficients::Moulton), "Коэффициенты метода Адамса несогласованы");
+
+    public:
+        static constexpr int Order = MethodOrder;
+
+    private:
+        RungeKutta4<State> starter;
+        std::array<State, Order> history;  // history[newest] = f_n, history[newest - j] = f_(n-j)
+        State predictedSlope;              // f в точке прогноза (режимы PEC и PECE)
+        State predicted;
+        int newest;
+        int stored;                        // сколько производных в истории (не больше Order)
+        bool currentKnown;                 // f_n текущей точки уже в истории (после шага PEC / PECE)
+        long long evaluations;
+
+    public:
+        explicit AdamsMultistep(const State& shape = State())
+            : starter(shape), predictedSlope(shape), predicted(shape)
+        {
+            history.fill(shape);
+            Reset();
+        }
+
+        void Reset()
+        {
+            newest = 0;
+            stored = 0;
+            currentKnown = false;
+            evaluations = 0;
+        }
+
+        long long GetEvaluationCount() const { return evaluations; }
+
+        template <typename System>
+        void Step(const System& system, double t, double h, State& y)
+        {
+            if (!currentKnown)
+            {
+                if (stored + 1 < Order)
+                {
+                    starter.Step(system, t, h, y);
+                    evaluations += ClassicRK4::Stages;
+                    Push(starter.GetSlope(0));
+                    return;
+                }
+                Advance();
+                system(t, y, history[newest]);
+                evaluations++;
+            }
+
+            // past[j] = f_(n-j): индексы кольца считаются один раз на шаг, а не на компоненту
+            std::array<const State*, Order> past;
+            for (int j = 0; j < Order; j++)
+                past[j] = &history[(newest - j + Order) % Order];
+
+            if constexpr (Mode == AdamsMode::Bashforth)
+            {
+                for (size_t i = 0; i < y.size(); i++)
+                    y[i] += h * Combination(past, Coefficients::Bashforth, i, 0);
+            }
+            else
+            {
+                for (size_t i = 0; i < y.size(); i++)
+                    predicted[i] = y[i] + h * Combination(past, Coefficients::Bashforth, i, 0);
+                system(t + h, predicted, predictedSlope);
+                evaluations++;
+
+                // Моултон: вес 0 - у f в точке прогноза, остальные - у f_n, f_(n-1), ...
+                for (size_t i = 0; i < y.size(); i++)
+                    y[i] += h * (Coefficients::Moulton[0] * predictedSlope[i] + Combination(past, Coefficients::Moulton, i, 1));
+
+                // Самая старая производная f_(n-Order+1) больше не нужна - её место занимает f_(n+1)
+                Advance();
+                if constexpr (Mode == AdamsMode::PEC)
+                    std::swap(history[newest], predictedSlope);
+                else
+                {
+                    system(t + h, y, history[newest]);
+                    evaluations++;
+                }
+                currentKnown = true;
+            }
+        }
+
+    private:
+        void Advance()
+        {
+            newest = (newest + 1) % Order;
+            stored = std::min(stored + 1, Order);
+        }
+
+        void Push(const State& slope)
+        {
+            Advance();
+            for (size_t i = 0; i < slope.size(); i++)
+                history[newest][i] = slope[i];
+        }
+
+        // sum_(j >= first) weights[j] f_(n+first-j): при first = 0 - веса Башфорта с f_n,
+        // при first = 1 - веса Моултона без f_(n+1)
+        static double Combination(const std::array<const State*, Order>& past, const double (&weights)[Order],
+            size_t i, int first)
+        {
+            double sum = 0.0;
+            for (int j = first; j < Order; j++)
+                sum += weights[j] * (*past[j - first])[i];
+            return sum;
+        }
+    };
+
+    template <int Order, typename State>
+    using AdamsBashforth = AdamsMultistep<Order, AdamsMode::Bashforth, State>;
+
+    template <int Order, typename State>
+    using AdamsBashforthMoulton = AdamsMultistep<Order, AdamsMode::PECE, State>;
+
+    template <typename State>
+    using AdamsBashforth2 = AdamsBashforth<2, State>;
+
+    // Управление шагом адаптивных методов
+    struct StepControl
+    {
+        double absoluteTolerance = 1e-8;
+        double relativeTolerance = 1e-8;
+        double initialStep = 0.0;      // 0 - подбирается по задаче (Hairer, Norsett, Wanner, II.4)
+        double maxStep = 0.0;          // 0 - без ограничения
+        long long maxSteps = 100000000;
+        double safety = 0.9;
+        double minFactor = 0.2;        // шаг за попытку уменьшается не более чем в 5 раз
+        double maxFactor = 10.0;       // и растёт не более чем в 10 раз
+        double beta = 0.04;            // PI-регулятор; 0 - обычный I-регулятор
+    };
+
+    // Метод Дорманда - Принса 5(4) с выбором шага по оценке локальной ошибки.
+    // Ошибка шага err = ||h sum E_s k_s|| в среднеквадратичной норме с масштабом
+    // atol + rtol max(|y|, |y_new|); шаг принимается при err <= 1. Новый шаг - PI-регулятор
+    // h_new = h safety err^(-alpha) errPrev^beta, alpha = 1/5 - 0.75 beta (как в DOPRI5).
+    // Последняя стадия шага - первая стадия следующего (FSAL): 6 вычислений f на шаг.
+    // После принятого шага Interpolate даёт решение 4-го порядка в любой точке шага,
+    // поэтому выдача на равномерной сетке не ограничивает длину шага (IntegrateOnGrid)
+    template <typename State>
+    class DormandPrince45 : private Detail::RungeKuttaStages<DormandPrince5, State>
+    {
+        using Tableau = DormandPrince5;
+        using Base = Detail::RungeKuttaStages<Tableau, State>;
+
+    public:
+        static constexpr int Order = Tableau::Order;
+
+    private:
+        StepControl control;
+
+        // Непрерывное продолжение на последнем шаге:
+        // y(t + theta h) = r0 + theta (r1 + (1 - theta) (r2 + theta (r3 + (1 - theta) r4)))
+        std::array<State, 5> dense;
+        double denseStart, denseStep;
+
+        double nextStep;
+        double previousError;
+        bool hasFirstSlope;
+        bool lastRejected;
+        long long evaluations, acceptedSteps, rejectedSteps;
+
+    public:
+        explicit DormandPrince45(const StepControl& stepControl = StepControl(), const State& shape = State())
+            : Base(shape), control(stepControl)
+        {
+            dense.fill(shape);
+            Reset();
+        }
+
+        // Сброс перед интегрированием из новой начальной точки
+        void Reset()
+        {
+            denseStart = denseStep = 0.0;
+            nextStep = control.initialStep;
+            previousError = 1e-4;
+            hasFirstSlope = false;
+            lastRejected = false;
+            evaluations = acceptedSteps = rejectedSteps = 0;
+        }
+
+        // Один принятый шаг из (t, y), не дальше tEnd; t и y переходят в конец шага
+        template <typename System>
+        void Step(const System& system, double& t, State& y, double tEnd)
+        {
+            double remaining = tEnd - t;
+            if (!(remaining > 0.0))
+                throw std::runtime_error("Конец интервала интегрирования должен лежать после текущего момента");
+
+            if (!hasFirstSlope)
+            {
+                system(t, y, Base::slopes[0]);
+                evaluations++;
+                hasFirstSlope = true;
+                if (nextStep <= 0.0)
+                    nextStep = InitialStep(system, t, y, remaining);
+            }
+
+            const double alpha = 0.2 - 0.75 * control.beta;
+            while (true)
+            {
+                if (acceptedSteps + rejectedSteps >= control.maxSteps)
+                    throw std::runtime_error("Превышено допустимое число шагов адаптивного метода");
+
+                double h = std::min(nextStep, remaining);
+                if (control.maxStep > 0.0)
+                    h = std::min(h, control.maxStep);
+                if (t + h == t)
+                    throw std::runtime_error("Шаг адаптивного метода меньше машинной точности");
+
+                // Седьмая стадия считается в точке y + h sum B_s k_s: stageState - новое решение
+                Base::template ComputeStages<1>(system, t, h, y);
+                evaluations += Tableau::Stages - 1;
+                const State& candidate = Base::stageState;
+
+                double error = ErrorNorm(h, y, candidate);
+                double growth = std::pow(error, alpha);
+                if (error <= 1.0)
+                {
+                    double factor = growth / std::pow(previousError, control.beta);
+                    factor = std::clamp(factor / control.safety, 1.0 / control.maxFactor, 1.0 / control.minFactor);
+                    double proposed = h / factor;
+                    if (lastRejected)
+                        proposed = std::min(proposed, h);
+                    previousError = std::max(error, 1e-4);
+
+                    BuildDenseOutput(t, h, y, candidate);
+                    for (size_t i = 0; i < y.size(); i++)
+                        y[i] = candidate[i];
+                    std::swap(Base::slopes[0], Base::slopes[Tableau::Stages - 1]);
+                    t = (h == remaining) ? tEnd : t + h;
+
+                    nextStep = proposed;
+                    lastRejected = false;
+                    acceptedSteps++;
+                    return;
+                }
+
+                nextStep = h / std::min(1.0 / control.minFactor, growth / control.safety);
+                lastRejected = true;
+                rejectedSteps++;
+            }
+        }
+
+        // Решение в момент tau последнего принятого шага
+        void Interpolate(double tau, State& output) const
+        {
+            double theta = (tau - denseStart) / denseStep;
+            double theta1 = 1.0 - theta;
+            for (size_t i = 0; i < output.size(); i++)
+                output[i] = dense[0][i] + theta * (dense[1][i] + theta1 * (dense[2][i] +
+                    theta * (dense[3][i] + theta1 * dense[4][i])));
+        }
+
+        long long GetEvaluationCount() const { return evaluations; }
+        long long GetAcceptedSteps() const { return acceptedSteps; }
+        long long GetRejectedSteps() const { return rejectedSteps; }
+
+    private:
+        double Scale(double value) const
+        {
+            return control.absoluteTolerance + control.relativeTolerance * std::fabs(value);
+        }
+
+        double ErrorNorm(double h, const State& y, const State& candidate) const
+        {
+            double sum = 0.0;
+            for (size_t i = 0; i < y.size(); i++)
+            {
+                double scaled = h * Base::Combination(Tableau::E, i) /
+                    Scale(std::max(std::fabs(y[i]), std::fabs(candidate[i])));
+                sum += scaled * scaled;
+            }
+            return std::sqrt(sum / y.size());
+        }
+
+        void BuildDenseOutput(double t, double h, const State& y, const State& candidate)
+        {
+            const State& firstSlope = Base::slopes[0];
+            const State& lastSlope = Base::slopes[Tableau::Stages - 1];
+            for (size_t i = 0; i < y.size(); i++)
+            {
+                double increment = candidate[i] - y[i];
+                double slopeDefect = h * firstSlope[i] - increment;
+                dense[0][i] = y[i];
+                dense[1][i] = increment;
+                dense[2][i] = slopeDefect;
+                dense[3][i] = increment - h * lastSlope[i] - slopeDefect;
+                dense[4][i] = h * Base::Combination(Tableau::D, i);
+            }
+            denseStart = t;
+            denseStep = h;
+        }
+
+        // Начальный шаг по норме решения и оценке второй производной (пробный шаг Эйлера)
+        template <typename System>
+        double InitialStep(const System& system, double t, const State& y, double remaining)
+        {
+            const State& slope = Base::slopes[0];
+            double stateNorm = 0.0, slopeNorm = 0.0;
+            for (size_t i = 0; i < y.size(); i++)
+            {
+                double scale = Scale(y[i]);
+                stateNorm += (y[i] / scale) * (y[i] / scale);
+                slopeNorm += (slope[i] / scale) * (slope[i] / scale);
+            }
+            stateNorm = std::sqrt(stateNorm / y.size());
+            slopeNorm = std::sqrt(slopeNorm / y.size());
+
+            double trial = (stateNorm < 1e-10 || slopeNorm < 1e-10) ? 1e-6 : 0.01 * stateNorm / slopeNorm;
+            trial = std::min(trial, remaining);
+
+            State& probe = Base::stageState;
+            State& probeSlope = Base::slopes[1];
+            for (size_t i = 0; i < y.size(); i++)
+                probe[i] = y[i] + trial * slope[i];
+            system(t + trial, probe, probeSlope);
+            evaluations++;
+
+            double curvature = 0.0;
+            for (size_t i = 0; i < y.size(); i++)
+            {
+                double scaled = (probeSlope[i] - slope[i]) / Scale(y[i]);
+                curvature += scaled * scaled;
+            }
+            curvature = std::sqrt(curvature / y.size()) / trial;
+
+            double largest = std::max(slopeNorm, curvature);
+            double estimate = (largest <= 1e-15) ? std::max(1e-6, trial * 1e-3)
+                : std::pow(0.01 / largest, 1.0 / Order);
+            double step = std::min(100.0 * trial, estimate);
+            return control.maxStep > 0.0 ? std::min(step, control.maxStep) : step;
+        }
+    };
+
+    // steps шагов длины h из (t0, y). observer(step, t, y) вызывается для начальной точки
+    // (step = 0) и после каждого шага; время считается как t0 + step * h без накопления ошибки
+    template <typename Stepper, typename System, typename State, typename Observer>
+    void Integrate(Stepper& stepper, const System& system, double t0, State& y, double h, int steps,
+        Observer&& observer)
+    {
+        observer(0, t0, y);
+        for (int step = 0; step < steps; step++)
+        {
+            stepper.Step(system, t0 + step * h, h, y);
+            observer(step + 1, t0 + (step + 1) * h, y);
+        }
+    }
+
+    // Отклонение первого интеграла |I - I0| / max(|I0|, 1): относительное при |I0| >= 1 и абсолютное
+    // при малых |I0|, так что I0 = 0 (допустимо: первый интеграл определён с точностью до константы)
+    // не даёт inf и NaN
+    inline double InvariantDeviation(double value, double initial)
+    {
+        return std::fabs(value - initial) / std::max(std::fabs(initial), 1.0);
+    }
+
+    // Наблюдатель за первым интегралом I(y) вдоль решения: отклонение InvariantDeviation -
+    // наибольшее по траектории и в последней точке. Память O(1),
+    // поэтому подходит для сколь угодно длинных прогонов; y0 - состояние при step = 0
+    template <typename Invariant>
+    class InvariantMonitor
+    {
+    private:
+        Invariant invariant;
+        double initial;
+        double maxDeviation, lastDeviation;
+
+    public:
+        explicit InvariantMonitor(const Invariant& firstIntegral)
+            : invariant(firstIntegral), initial(0.0), maxDeviation(0.0), lastDeviation(0.0)
+        {
+        }
+
+        template <typename State>
+        void operator()(long long step, double, const State& y)
+        {
+            double value = invariant(y);
+            if (step == 0)
+            {
+                initial = value;
+                maxDeviation = lastDeviation = 0.0;
+                return;
+            }
+            lastDeviation = InvariantDeviation(value, initial);
+            maxDeviation = std::max(maxDeviation, lastDeviation);
+        }
+
+        double GetMaxDeviation() const { return maxDeviation; }
+        double GetFinalDeviation() const { return lastDeviation; }
+    };
+
+    // Адаптивное интегрирование с выдачей на равномерной сетке t0 + n * outputStep, n = 0..outputCount.
+    // Шаги выбирает solver по точности, значения в узлах берутся из непрерывного продолжения;
+    // observer(n, t, y) - как в Integrate. По окончании y - решение в t0 + outputCount * outputStep
+    template <typename State, typename System, typename Observer>
+    void IntegrateOnGrid(DormandPrince45<State>& solver, const System& system, double t0, State& y,
+        double outputStep, int outputCount, Observer&& observer)
+    {
+        observer(0, t0, y);
+        if (outputCount <= 0)
+            return;
+
+        State sample(y);
+        double t = t0;
+        double tEnd = t0 + outputCount * outputStep;
+        int next = 1;
+        while (next <= outputCount)
+        {
+            solver.Step(system, t, y, tEnd);
+            for (; next <= outputCount && (t0 + next * outputStep <= t || t == tEnd); next++)
+            {
+                double tau = t0 + next * outputStep;
+                solver.Interpolate(tau, sample);
+                observer(next, tau, sample);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,241 @@
+#pragma once
+#ifndef PREDATOR_PREY_H
+#define PREDATOR_PREY_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "OdeSolvers.h"
+#include "LotkaVolterra.h"
+#include "EnsembleSolver.h"
+#include "SplittingMethods.h"
+#include "TrajectorySink.h"
+#include "../CM_7/NumericTextWriter.h"
+
+namespace Ode
+{
+    // Общая часть программ CM_8: интегрирование модели RK4 и методами Адамса с постоянным шагом или DP45
+    // с выбором шага. Траектория копится в памяти (TrajectorySink) и после прогона пишется в
+    // <prey>_<suffix>_<метод>.txt, <pred>_..., phase_... (по отсчёту на строку) либо в один
+    // trajectory_<suffix>_<метод>.npz (SetOutput). DP45 и симплектические методы (SolveSplitting)
+    // выдают решение на той же сетке, что и RK4; для каждого прогона печатается отклонение инварианта.
+    // SolveEnsemble - RK4 по сетке начальных условий с итогами в ensemble_<suffix>_rk4.txt
+    class PredatorPreyExperiment
+    {
+    private:
+        static constexpr int OUTPUT_DIGITS = 6; // знаков после запятой в файлах траекторий
+
+        LotkaVolterra model;
+        double totalTime;
+        double stepRk4, stepAb;
+        std::string preyPrefix, predatorPrefix;
+        StepControl adaptiveControl;
+        TrajectoryFormat outputFormat = TrajectoryFormat::Text;
+        int outputDecimation = 1;
+
+        // Отклонение первого интеграла вдоль прогона (InvariantDeviation); определён до использования,
+        // так как тип результата выводится (auto)
+        auto CreateMonitor() const
+        {
+            const LotkaVolterra& lotkaVolterra = model;
+            return InvariantMonitor([&lotkaVolterra](const LotkaVolterra::State& y) { return lotkaVolterra.Invariant(y); });
+        }
+
+    public:
+        PredatorPreyExperiment(const LotkaVolterra& lotkaVolterra, double time, double rk4Step, double abStep,
+            const std::string& preyFilePrefix, const std::string& predatorFilePrefix)
+            : model(lotkaVolterra), totalTime(time), stepRk4(rk4Step), stepAb(abStep),
+            preyPrefix(preyFilePrefix), predatorPrefix(predatorFilePrefix)
+        {
+        }
+
+        const LotkaVolterra& GetModel() const { return model; }
+
+        void SetAdaptiveControl(const StepControl& control) { adaptiveControl = control; }
+
+        // В файл идёт каждый decimation-й отсчёт сетки
+        void SetOutput(TrajectoryFormat format, int decimation)
+        {
+            if (decimation < 1)
+                throw std::runtime_error("Прореживание траектории должно быть не меньше 1");
+            outputFormat = format;
+            outputDecimation = decimation;
+        }
+
+        void SolveRk4(const std::string& suffix, double x0, double y0) const
+        {
+            RungeKutta4<LotkaVolterra::State> stepper;
+            Solve(stepper, stepRk4, "rk4", "RK4", suffix, x0, y0);
+        }
+
+        // Метод Адамса с шагом abStep: файлы *_ab<k>.txt (Bashforth), *_abm<k>.txt (PECE), *_abm<k>_pec.txt
+        template <int Order, AdamsMode Mode = AdamsMode::Bashforth>
+        void SolveAdams(const std::string& suffix, double x0, double y0) const
+        {
+            AdamsMultistep<Order, Mode, LotkaVolterra::State> stepper;
+            std::string order = std::to_string(Order);
+            if constexpr (Mode == AdamsMode::Bashforth)
+                Solve(stepper, stepAb, "ab" + order, "AB" + order, suffix, x0, y0);
+            else if constexpr (Mode == AdamsMode::PECE)
+                Solve(stepper, stepAb, "abm" + order, "ABM" + order + " (PECE)", suffix, x0, y0);
+            else
+                Solve(stepper, stepAb, "abm" + order + "_pec", "ABM" + order + " (PEC)", suffix, x0, y0);
+        }
+
+        // Симплектическое расщепление в логарифмических переменных с шагом rk4Step: файлы *_split<порядок>.txt
+        template <typename Composition>
+        void SolveSplitting(const std::string& suffix, double x0, double y0) const
+        {
+            LogSplittingLotkaVolterra<Composition> stepper;
+            std::string order = std::to_string(Composition::Order);
+            Solve(stepper, stepRk4, "split" + order, "Расщепление " + order + "-го порядка", suffix, x0, y0);
+        }
+
+        // DP45 с выдачей на сетке RK4. Для сравнения при равной точности печатаются число вычислений f
+        // и наибольшая относительная ошибка на сетке у обоих методов; эталон - DP45 с допусками
+        // REFERENCE_TOLERANCE. Допуски DP45 задаёт SetAdaptiveControl
+        void SolveDopri5(const std::string& suffix, double x0, double y0) const
+        {
+            int outputCount = static_cast<int>(totalTime / stepRk4);
+            DormandPrince45<LotkaVolterra::State> solver(adaptiveControl);
+            TrajectorySink trajectory = CreateSink(outputCount);
+            auto monitor = CreateMonitor();
+            std::vector<LotkaVolterra::State> reference = ReferenceSolution(x0, y0, outputCount);
+            double error = 0.0;
+
+            LotkaVolterra::State state = { x0, y0 };
+            IntegrateOnGrid(solver, model, 0.0, state, stepRk4, outputCount,
+                [&](int step, double t, const LotkaVolterra::State& y)
+                {
+                    trajectory(step, t, y);
+                    monitor(step, t, y);
+                    error = std::max(error, RelativeError(y, reference[step]));
+                });
+            SaveTrajectory(trajectory, suffix, "dp45");
+
+            // RK4 повторяется без записи файлов, только ради ошибки на той же сетке
+            RungeKutta4<LotkaVolterra::State> rk4;
+            double rk4Error = 0.0;
+            state = { x0, y0 };
+            Integrate(rk4, model, 0.0, state, stepRk4, outputCount,
+                [&](int step, double, const LotkaVolterra::State& y) { rk4Error = std::max(rk4Error, RelativeError(y, reference[step])); });
+
+            std::cout << "DP45 (" << suffix << ") завершён: " << outputCount + 1 << " точек, шагов "
+                << solver.GetAcceptedSteps() << " (отклонено " << solver.GetRejectedSteps() << "), вычислений f: "
+                << solver.GetEvaluationCount() << " при ошибке " << error << " против " << 4LL * outputCount
+                << " у RK4 при ошибке " << rk4Error << ", отклонение инварианта " << monitor.GetMaxDeviation() << "\n";
+        }
+
+        // Ансамбль начальных условий x0 = sx X*, y0 = sy Y* для всех пар множителей (sx, sy).
+        // Строка файла на член ансамбля: x0 y0 min x, max x, min y, max y, средние x и y, дрейф инварианта
+        void SolveEnsemble(const std::string& suffix, const std::vector<double>& preyScales,
+            const std::vector<double>& predatorScales) const
+        {
+            LotkaVolterraEnsemble ensemble;
+            for (double sx : preyScales)
+                for (double sy : predatorScales)
+                    ensemble.Add(model, sx * model.PreyEquilibrium(), sy * model.PredatorEquilibrium());
+
+            EnsembleOptions options;
+            options.step = stepRk4;
+            options.steps = static_cast<int>(totalTime / stepRk4);
+            EnsembleResult result;
+            EnsembleSolver<ClassicRK4>::Run(ensemble, options, result);
+
+            SignalProcessing::NumericTextWriter out("ensemble_" + suffix + "_rk4.txt", ' ');
+            double maxDrift = 0.0;
+            for (size_t m = 0; m < ensemble.Size(); m++)
+            {
+                out.Fixed(ensemble.prey[m], OUTPUT_DIGITS).Fixed(ensemble.predator[m], OUTPUT_DIGITS)
+                    .Fixed(result.minPrey[m], OUTPUT_DIGITS).Fixed(result.maxPrey[m], OUTPUT_DIGITS)
+                    .Fixed(result.minPredator[m], OUTPUT_DIGITS).Fixed(result.maxPredator[m], OUTPUT_DIGITS)
+                    .Fixed(result.meanPrey[m], OUTPUT_DIGITS).Fixed(result.meanPredator[m], OUTPUT_DIGITS)
+                    .Column(result.invariantDrift[m]).EndRow();
+                maxDrift = std::max(maxDrift, result.invariantDrift[m]);
+            }
+
+            std::cout << "Ансамбль RK4 (" << suffix << ") завершён: " << ensemble.Size() << " траекторий по "
+                << options.steps + 1 << " точек, наибольший дрейф инварианта " << maxDrift << "\n";
+        }
+
+    private:
+        static constexpr double REFERENCE_TOLERANCE = 1e-13;
+
+        // Эталонное решение на сетке stepRk4, n = 0..outputCount
+        std::vector<LotkaVolterra::State> ReferenceSolution(double x0, double y0, int outputCount) const
+        {
+            StepControl control;
+            control.absoluteTolerance = control.relativeTolerance = REFERENCE_TOLERANCE;
+            DormandPrince45<LotkaVolterra::State> solver(control);
+
+            std::vector<LotkaVolterra::State> reference(outputCount + 1);
+            LotkaVolterra::State state = { x0, y0 };
+            IntegrateOnGrid(solver, model, 0.0, state, stepRk4, outputCount,
+                [&reference](int step, double, const LotkaVolterra::State& y) { reference[step] = y; });
+            return reference;
+        }
+
+        // Наибольшая по компонентам относительная ошибка (численности положительны)
+        static double RelativeError(const LotkaVolterra::State& y, const LotkaVolterra::State& reference)
+        {
+            double error = 0.0;
+            for (size_t i = 0; i < y.size(); i++)
+                error = std::max(error, std::fabs(y[i] - reference[i]) / std::fabs(reference[i]));
+            return error;
+        }
+
+        TrajectorySink CreateSink(long long steps) const
+        {
+            TrajectorySink trajectory({ preyPrefix, predatorPrefix }, outputDecimation);
+            trajectory.Reserve(steps);
+            return trajectory;
+        }
+
+        // Запись накопленной траектории одного прогона
+        void SaveTrajectory(const TrajectorySink& trajectory, const std::string& suffix,
+            const std::string& methodTag) const
+        {
+            std::string name = suffix + "_" + methodTag;
+            if (outputFormat == TrajectoryFormat::Npz)
+            {
+                trajectory.Save("trajectory_" + name + ".npz");
+                return;
+            }
+
+            SignalProcessing::NumericTextWriter preyOut(preyPrefix + "_" + name + ".txt", ' ');
+            SignalProcessing::NumericTextWriter predatorOut(predatorPrefix + "_" + name + ".txt", ' ');
+            SignalProcessing::NumericTextWriter phaseOut("phase_" + name + ".txt", ' ');
+            const std::vector<double>& prey = trajectory.GetColumn(0);
+            const std::vector<double>& predator = trajectory.GetColumn(1);
+            for (size_t k = 0; k < trajectory.Size(); k++)
+            {
+                preyOut.Fixed(prey[k], OUTPUT_DIGITS).EndRow();
+                predatorOut.Fixed(predator[k], OUTPUT_DIGITS).EndRow();
+                phaseOut.Fixed(prey[k], OUTPUT_DIGITS).Fixed(predator[k], OUTPUT_DIGITS).EndRow();
+            }
+        }
+
+        template <typename Stepper>
+        void Solve(Stepper& stepper, double h, const std::string& methodTag, const std::string& methodName,
+            const std::string& suffix, double x0, double y0) const
+        {
+            int steps = static_cast<int>(totalTime / h);
+            TrajectorySink trajectory = CreateSink(steps);
+            auto monitor = CreateMonitor();
+
+            LotkaVolterra::State state = { x0, y0 };
+            Integrate(stepper, model, 0.0, state, h, steps,
+                [&](int step, double t, const LotkaVolterra::State& y) { trajectory(step, t, y); monitor(step, t, y); });
+            SaveTrajectory(trajectory, suffix, methodTag);
+
+            std::cout << methodName << " (" << suffix << ") завершён: " << steps + 1 << " точек, отклонение инварианта "
+                << monitor.GetMaxDeviation() << "\n";
+        }
+    };
+}
+
+#endif
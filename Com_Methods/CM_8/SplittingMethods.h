@@ -0,0 +1,115 @@
+#pragma once
+#ifndef SPLITTING_METHODS_H
+#define SPLITTING_METHODS_H
+
+#include <cmath>
+#include <stdexcept>
+#include "LotkaVolterra.h"
+
+namespace Ode
+{
+    // Симметричные композиции шага Штёрмера - Верле S(h): Psi(h) = S(W[S-1] h) ... S(W[0] h).
+    // Композиция симплектических шагов симплектична; веса симметричны и в сумме дают 1,
+    // Order - порядок получающегося метода (Yoshida, 1990)
+
+    // Штёрмер - Верле (Стрэнг), порядок 2
+    struct StormerVerlet
+    {
+        static constexpr int Stages = 1;
+        static constexpr int Order = 2;
+        static constexpr double W[Stages] = { 1.0 };
+    };
+
+    // Тройной прыжок Йошиды, порядок 4: w1 = 1 / (2 - 2^(1/3)), w0 = 1 - 2 w1
+    struct Yoshida4
+    {
+        static constexpr int Stages = 3;
+        static constexpr int Order = 4;
+        static constexpr double W[Stages] = { 1.3512071919596578, -1.7024143839193153, 1.3512071919596578 };
+    };
+
+    // Йошида, порядок 6 (решение A): семь шагов, w0 = 1 - 2 (w1 + w2 + w3)
+    struct Yoshida6
+    {
+        static constexpr int Stages = 7;
+        static constexpr int Order = 6;
+        static constexpr double W[Stages] = {
+            0.784513610477560, 0.235573213359357, -1.17767998417887, 1.3151863206839063,
+            -1.17767998417887, 0.235573213359357, 0.784513610477560 };
+    };
+
+    template <typename Composition>
+    constexpr bool IsSymmetricComposition()
+    {
+        double sum = 0.0;
+        for (int s = 0; s < Composition::Stages; s++)
+        {
+            if (Composition::W[s] != Composition::W[Composition::Stages - 1 - s])
+                return false;
+            sum += Composition::W[s];
+        }
+        return sum - 1.0 <= 1e-13 && 1.0 - sum <= 1e-13;
+    }
+
+    // Лотка - Вольтерра в логарифмических переменных u = ln x, v = ln y:
+    //   u' = alpha - beta e^v,  v' = delta e^u - gamma
+    // - гамильтонова система с H(u, v) = delta e^u - gamma u + beta e^v - alpha v (это первый интеграл
+    // LotkaVolterra::Invariant). H = A(u) + B(v), и поток каждой части точен: при фиксированном v
+    // u растёт линейно, и наоборот. Шаг Верле из этих потоков и его композиции симплектичны:
+    // ошибка инварианта ограничена на любом горизонте, а не накапливается, как у RK4 и AB.
+    // Соседние полушаги по u в композиции сливаются: 2 Stages + 1 экспоненты на шаг.
+    // Численности остаются положительными при любом шаге
+    template <typename Composition>
+    class LogSplittingLotkaVolterra
+    {
+        static_assert(IsSymmetricComposition<Composition>(), "Веса композиции должны быть симметричны и давать в сумме 1");
+
+    public:
+        static constexpr int Order = Composition::Order;
+
+    private:
+        // Логарифмы состояния после последнего шага: если следующий шаг начинается
+        // из того же (x, y), ln не пересчитывается и не вносит ошибок округления
+        double u, v;
+        double lastPrey, lastPredator;
+        bool cached;
+
+    public:
+        LogSplittingLotkaVolterra()
+            : u(0.0), v(0.0), lastPrey(0.0), lastPredator(0.0), cached(false)
+        {
+        }
+
+        void Reset() { cached = false; }
+
+        void Step(const LotkaVolterra& model, double, double h, LotkaVolterra::State& y)
+        {
+            if (!cached || y[0] != lastPrey || y[1] != lastPredator)
+            {
+                if (!(y[0] > 0.0 && y[1] > 0.0))
+                    throw std::runtime_error("Логарифмические переменные требуют положительных численностей");
+                u = std::log(y[0]);
+                v = std::log(y[1]);
+            }
+
+            double expV = 0.0;
+            double previousWeight = 0.0;
+            for (int s = 0; s < Composition::Stages; s++)
+            {
+                double weight = Composition::W[s];
+                expV = std::exp(v);
+                u += 0.5 * (previousWeight + weight) * h * (model.alpha - model.beta * expV);
+                v += weight * h * (model.delta * std::exp(u) - model.gamma);
+                previousWeight = weight;
+            }
+            expV = std::exp(v);
+            u += 0.5 * previousWeight * h * (model.alpha - model.beta * expV);
+
+            y[0] = lastPrey = std::exp(u);
+            y[1] = lastPredator = expV;
+            cached = true;
+        }
+    };
+}
+
+#endif
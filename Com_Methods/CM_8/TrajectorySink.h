@@ -0,0 +1,83 @@
+#pragma once
+#ifndef TRAJECTORY_SINK_H
+#define TRAJECTORY_SINK_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../CM_7/NpyWriter.h"
+
+namespace Ode
+{
+    // Формат траекторий прогона: текст (файл на величину, строка на отсчёт)
+    // или один архив .npz со столбцами "t" и по столбцу на компоненту состояния
+    enum class TrajectoryFormat
+    {
+        Text,
+        Npz
+    };
+
+    // Наблюдатель для Integrate / IntegrateOnGrid, копящий прореженную траекторию в памяти
+    // по столбцам: в цикле решателя - только запись чисел в заранее выделенные массивы,
+    // без форматирования и обращений к файлу. Записывается каждый decimation-й отсчёт
+    // (step % decimation == 0); отсчёты в заданные моменты времени даёт IntegrateOnGrid
+    // с нужным шагом выдачи. Save пишет всё одним архивом:
+    //   data = np.load(path); t, x = data["t"], data[names[0]]
+    class TrajectorySink
+    {
+    private:
+        std::vector<std::string> names;
+        int decimation;
+        std::vector<double> times;
+        std::vector<std::vector<double>> columns;
+
+    public:
+        explicit TrajectorySink(const std::vector<std::string>& componentNames, int decimationFactor = 1)
+            : names(componentNames), decimation(decimationFactor), columns(componentNames.size())
+        {
+            if (decimation < 1)
+                throw std::runtime_error("Прореживание траектории должно быть не меньше 1");
+            for (const std::string& name : names)
+                if (name == "t")
+                    throw std::runtime_error("Имя \"t\" занято столбцом времени");
+        }
+
+        // Выделяет память под отсчёты steps шагов, чтобы запись не перераспределяла массивы
+        void Reserve(long long steps)
+        {
+            size_t samples = static_cast<size_t>(steps / decimation + 1);
+            times.reserve(samples);
+            for (std::vector<double>& column : columns)
+                column.reserve(samples);
+        }
+
+        size_t Size() const { return times.size(); }
+        const std::vector<double>& GetTimes() const { return times; }
+        const std::vector<double>& GetColumn(size_t component) const { return columns[component]; }
+
+        template <typename State>
+        void operator()(long long step, double t, const State& y)
+        {
+            if (step % decimation != 0)
+                return;
+            if (y.size() != columns.size())
+                throw std::runtime_error("Размер состояния не совпадает с числом столбцов траектории");
+
+            times.push_back(t);
+            for (size_t i = 0; i < columns.size(); i++)
+                columns[i].push_back(y[i]);
+        }
+
+        void Save(const std::string& path) const
+        {
+            SignalProcessing::NpzArchive archive(path);
+            archive.Add("t", times);
+            for (size_t i = 0; i < columns.size(); i++)
+                archive.Add(names[i], columns[i]);
+            archive.Close();
+        }
+    };
+}
+
+#endif